@@ -25,7 +25,7 @@ public class MaySimpleRecoil : ModuleRules
 		PublicDependencyModuleNames.AddRange(
 			new string[]
 			{
-				"Core", "Engine",
+				"Core", "Engine", "DeveloperSettings",
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -49,5 +49,8 @@ public class MaySimpleRecoil : ModuleRules
 				// ... add any modules that your module loads dynamically here ...
 			}
 			);
+
+		// Gameplay Debugger category (defines WITH_GAMEPLAY_DEBUGGER)
+		SetupGameplayDebuggerSupport(Target);
 	}
 }
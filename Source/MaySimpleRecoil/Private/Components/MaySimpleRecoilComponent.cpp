@@ -3,28 +3,191 @@
 
 #include "Components/MaySimpleRecoilComponent.h"
 
+#include "Core/Data/MayRecoilData.h"
+#include "Core/Data/MayRecoilModifierData.h"
+#include "Core/Subsystem/MayRecoilSubsystem.h"
+#include "MayRecoilStats.h"
+
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Net/UnrealNetwork.h"
+#include "TimerManager.h"
+#include "CoreGlobals.h"
 
 UMaySimpleRecoilComponent::UMaySimpleRecoilComponent()
 {
 	PrimaryComponentTick.bCanEverTick = true;
+
+	// Only the recoil seed is replicated
+	SetIsReplicatedByDefault(true);
+}
+
+void UMaySimpleRecoilComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(UMaySimpleRecoilComponent, RecoilSeed);
+}
+
+void UMaySimpleRecoilComponent::SetRecoilSeed(int32 NewSeed)
+{
+	if (GetOwner() && GetOwner()->HasAuthority())
+	{
+		RecoilSeed = NewSeed;
+	}
+}
+
+void UMaySimpleRecoilComponent::GenerateShot(const UMayRecoilData* Data, float Scale, FMayRecoilRandom& Random, int32 PatternShotIndex, float& OutYaw, float& OutPitch)
+{
+	MAYRECOIL_SCOPE_CYCLE_COUNTER(STAT_MayRecoilGenerateShot);
+
+	const bool bPredicting = bServerAuthoritativeRecoil && GetOwnerRole() == ROLE_AutonomousProxy;
+
+	// The server only knows CalculateRecoilScale, a scale overridden in the worker would never match
+	if (bPredicting)
+	{
+		Scale = CalculateRecoilScale(Data);
+	}
+
+	const int32 ShotIndex = Random.ShotIndex;
+	CalculateRecoilYawAndPitchStrength(Data, Scale, Random.NextShot(RecoilSeed), PatternShotIndex, OutYaw, OutPitch);
+
+	// Predicting client: let the server validate the shot, all shots of a frame are sent together
+	if (bPredicting)
+	{
+		if (PendingNetShots.Num() == 0)
+		{
+			GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UMaySimpleRecoilComponent::FlushNetShots);
+		}
+		PendingNetShots.Emplace(ShotIndex, PatternShotIndex, GetMovementState(), OutYaw, OutPitch);
+	}
+}
+
+void UMaySimpleRecoilComponent::FlushNetShots()
+{
+	if (PendingNetShots.Num() == 0) return;
+
+	ServerRecoilShots(PendingNetShots);
+	PendingNetShots.Reset();
+}
+
+void UMaySimpleRecoilComponent::ServerRecoilShots_Implementation(const TArray<FMayRecoilNetShot>& Shots)
+{
+	for (const FMayRecoilNetShot& Shot : Shots)
+	{
+		ValidateRecoilShot(Shot);
+	}
+}
+
+void UMaySimpleRecoilComponent::ValidateRecoilShot(const FMayRecoilNetShot& Shot)
+{
+	if (!bServerAuthoritativeRecoil) return;
+	const UMayRecoilData* Data = UpdateRecoilData();
+	if (!Data) return; // RecoilData must be valid
+
+	// Shots are sent unreliably: older shots arrived late, newer ones mean the shots in between were lost
+	if (Shot.ShotIndex < ServerRandom.ShotIndex) return;
+
+	// Lost shots must have been fired since the last validated shot, a forged index would skip all later shots
+	const float Now = GetWorld()->GetTimeSeconds();
+	const float TimeSinceLastShot = Now - ServerLastShotTime;
+	const int64 MaxLostShots = FMath::CeilToInt64(FMath::Clamp(TimeSinceLastShot, 0.0f, Now) * FMath::Max(NetMaxFireRate, 1.0f)) + 1;
+	if (static_cast<int64>(Shot.ShotIndex) - ServerRandom.ShotIndex > MaxLostShots) return;
+
+	const int32 NumLostShots = Shot.ShotIndex - ServerRandom.ShotIndex;
+	ServerRandom.ShotIndex = Shot.ShotIndex;
+	ServerLastShotTime = Now;
+
+	// The client resets the pattern once the add phase and the reset delay after the last shot are over
+	const float SprayTime = (Data->RecoilSpeed > 0.0f ? 1.0f / Data->RecoilSpeed : 0.0f) + Data->RecoilResetDelay;
+
+	int32 PatternShotIndex = TimeSinceLastShot > SprayTime ? 0 : ServerPatternIndex + NumLostShots;
+	if (Shot.PatternIndex != PatternShotIndex && FMath::Abs(TimeSinceLastShot - SprayTime) <= NetSprayResetTolerance &&
+		(Shot.PatternIndex == 0 || Shot.PatternIndex == ServerPatternIndex))
+	{
+		// Too close to the end of the spray to tell, both indices are plausible
+		PatternShotIndex = Shot.PatternIndex;
+	}
+	else if (NumLostShots > 0 && Shot.PatternIndex <= ServerPatternIndex + NumLostShots)
+	{
+		// The lost shots may have ended the spray, any index they could have reached is plausible
+		PatternShotIndex = Shot.PatternIndex;
+	}
+
+	// Physical states come from the server, input states (ADS, custom) from the client
+	constexpr EMayRecoilMovementState ClientStates = EMayRecoilMovementState::ADS | EMayRecoilMovementState::Custom1 | EMayRecoilMovementState::Custom2 | EMayRecoilMovementState::Custom3;
+	const EMayRecoilMovementState State = (GetMovementState() & ~ClientStates) | (Shot.GetMovementState() & ClientStates);
+
+	float Yaw = 0.0f;
+	float Pitch = 0.0f;
+	CalculateRecoilYawAndPitchStrength(Data, Data->GetStateScale(State), ServerRandom.NextShot(RecoilSeed), PatternShotIndex, Yaw, Pitch);
+	ServerPatternIndex = PatternShotIndex + 1;
+
+	const FVector2D Error = FVector2D(Yaw, Pitch) - Shot.GetYawAndPitch();
+	if (FMath::Abs(Error.X) <= NetRecoilTolerance && FMath::Abs(Error.Y) <= NetRecoilTolerance)
+	{
+		return; // Prediction matches, nothing to send
+	}
+
+	ClientRecoilCorrection(FMayRecoilNetCorrection(ServerRandom.ShotIndex, ServerPatternIndex, Error));
+	OnRecoilValidationFailed.Broadcast(Shot.ShotIndex, Error);
+}
+
+void UMaySimpleRecoilComponent::ClientRecoilCorrection_Implementation(const FMayRecoilNetCorrection& Correction)
+{
+	// The indices are only taken over if no shot was fired since the corrected one, see FMayRecoilRandom::ApplyCorrection
+	const FVector2D Delta = Correction.GetDelta();
+
+	if (WorkerMode != EMayRecoilWorkerMode::Actor)
+	{
+		UMayRecoilSubsystem* RecoilSubsystem = GetWorld()->GetSubsystem<UMayRecoilSubsystem>();
+		if (FMayRecoilState* State = RecoilSubsystem ? RecoilSubsystem->FindState(this) : nullptr)
+		{
+			State->ApplyCorrection(Correction.NextShotIndex, Correction.NextPatternIndex, Delta);
+		}
+	}
+	else if (RecoilWorkerInstance)
+	{
+		RecoilWorkerInstance->ApplyCorrection(Correction.NextShotIndex, Correction.NextPatternIndex, Delta);
+	}
+
+	ApplyRecoilYawAndPitch(Delta.X, Delta.Y);
 }
 
 void UMaySimpleRecoilComponent::TrySpawnRecoilWorkerInstance()
 {
 	if (!RecoilWorkerInstance)
 	{
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.Owner = CharacterOwner;
-		SpawnParams.Instigator = CharacterOwner->GetInstigator();
-
-		RecoilWorkerInstance = GetWorld()->SpawnActor<AMayRecoilWorker>(RecoilWorker, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+		if (UMayRecoilSubsystem* RecoilSubsystem = GetWorld()->GetSubsystem<UMayRecoilSubsystem>())
+		{
+			RecoilWorkerInstance = RecoilSubsystem->AcquireWorker(RecoilWorker, this);
+		}
+	}
+}
 
-		if (RecoilWorkerInstance)
+void UMaySimpleRecoilComponent::ReleaseRecoilWorkerInstance()
+{
+	if (RecoilWorkerInstance)
+	{
+		if (UMayRecoilSubsystem* RecoilSubsystem = GetWorld()->GetSubsystem<UMayRecoilSubsystem>())
 		{
-			RecoilWorkerInstance->SetCurrentComponent(this);
+			RecoilSubsystem->ReleaseWorker(RecoilWorkerInstance);
 		}
+		RecoilWorkerInstance = nullptr;
+	}
+}
+
+void UMaySimpleRecoilComponent::OnOwnerControllerChanged(APawn* Pawn, AController* OldController, AController* NewController)
+{
+	if (NewController)
+	{
+		TrySpawnRecoilWorkerInstance();
+	}
+	else
+	{
+		ReleaseRecoilWorkerInstance();
 	}
 }
 
@@ -33,8 +196,80 @@ void UMaySimpleRecoilComponent::BeginPlay()
 	Super::BeginPlay();
 
 	CharacterOwner = Cast<ACharacter>(GetOwner());
+	ActiveRecoilData = RecoilData;
+	ConfiguredRecoilData = RecoilData;
+	bUpdatePlayerYawAndPitchInScript = GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UMaySimpleRecoilComponent, UpdatePlayerYawAndPitch));
 
-	TrySpawnRecoilWorkerInstance();
+	// The server picks the seed, clients receive it through replication
+	if (RecoilSeed == 0 && GetOwner()->HasAuthority())
+	{
+		RecoilSeed = FMath::Rand() + 1;
+	}
+
+	if (WorkerMode != EMayRecoilWorkerMode::Actor)
+	{
+		if (UMayRecoilSubsystem* RecoilSubsystem = GetWorld()->GetSubsystem<UMayRecoilSubsystem>())
+		{
+			RecoilSubsystem->RegisterComponent(this);
+		}
+
+		if (WorkerMode == EMayRecoilWorkerMode::Object && !RecoilWorkerObject)
+		{
+			const TSubclassOf<UMayRecoilWorkerObject> ObjectClass = RecoilWorkerObjectClass ? RecoilWorkerObjectClass : TSubclassOf<UMayRecoilWorkerObject>(UMayRecoilWorkerObject::StaticClass());
+			RecoilWorkerObject = NewObject<UMayRecoilWorkerObject>(this, ObjectClass);
+			RecoilWorkerObject->SetCurrentComponent(this);
+		}
+	}
+	else
+	{
+		// The worker is spawned into the pool now, not when the pawn is possessed
+		if (UMayRecoilSubsystem* RecoilSubsystem = GetWorld()->GetSubsystem<UMayRecoilSubsystem>())
+		{
+			RecoilSubsystem->AddWorkerDemand(RecoilWorker);
+		}
+
+		if (APawn* PawnOwner = Cast<APawn>(GetOwner()))
+		{
+			// Pawns only hold a worker while they are possessed
+			PawnOwner->ReceiveControllerChangedDelegate.AddDynamic(this, &UMaySimpleRecoilComponent::OnOwnerControllerChanged);
+			if (PawnOwner->GetController())
+			{
+				TrySpawnRecoilWorkerInstance();
+			}
+		}
+		else
+		{
+			TrySpawnRecoilWorkerInstance();
+		}
+	}
+}
+
+void UMaySimpleRecoilComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (APawn* PawnOwner = Cast<APawn>(GetOwner()))
+	{
+		PawnOwner->ReceiveControllerChangedDelegate.RemoveDynamic(this, &UMaySimpleRecoilComponent::OnOwnerControllerChanged);
+	}
+
+	ReleaseRecoilWorkerInstance();
+	CachedRecoilStates.Empty();
+
+	// Same as releasing a pooled worker, the Blueprint hook of the worker object sees the reset
+	if (RecoilWorkerObject)
+	{
+		RecoilWorkerObject->ResetRecoilState();
+	}
+
+	if (UMayRecoilSubsystem* RecoilSubsystem = GetWorld()->GetSubsystem<UMayRecoilSubsystem>())
+	{
+		if (WorkerMode == EMayRecoilWorkerMode::Actor)
+		{
+			RecoilSubsystem->RemoveWorkerDemand(RecoilWorker);
+		}
+		RecoilSubsystem->UnregisterComponent(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void UMaySimpleRecoilComponent::InitializeComponent()
@@ -46,17 +281,57 @@ void UMaySimpleRecoilComponent::InitializeComponent()
 
 void UMaySimpleRecoilComponent::Recoil()
 {
+	UMayRecoilData* Data = UpdateRecoilData();
+
+	if (WorkerMode == EMayRecoilWorkerMode::Object)
+	{
+		if (RecoilWorkerObject && Data)
+		{
+			RecoilWorkerObject->SetCurrentRecoilData(Data);
+			RecoilWorkerObject->Recoil();
+		}
+		return;
+	}
+
+	if (WorkerMode == EMayRecoilWorkerMode::Subsystem)
+	{
+		if (UMayRecoilSubsystem* RecoilSubsystem = GetWorld()->GetSubsystem<UMayRecoilSubsystem>())
+		{
+			RecoilSubsystem->Recoil(this, Data);
+		}
+		return;
+	}
+
 	TrySpawnRecoilWorkerInstance();
 	
-	if (RecoilWorkerInstance && RecoilData)
+	if (RecoilWorkerInstance && Data)
 	{
-		RecoilWorkerInstance->SetCurrentRecoilData(RecoilData);
+		RecoilWorkerInstance->SetCurrentRecoilData(Data);
 		RecoilWorkerInstance->Recoil();
 	}
 }
 
 void UMaySimpleRecoilComponent::OnYawAdded(float Yaw)
 {
+	if (WorkerMode == EMayRecoilWorkerMode::Object)
+	{
+		if (RecoilWorkerObject)
+		{
+			RecoilWorkerObject->OnYawAdded(Yaw);
+		}
+		return;
+	}
+
+	if (WorkerMode == EMayRecoilWorkerMode::Subsystem)
+	{
+		UMayRecoilSubsystem* RecoilSubsystem = GetWorld()->GetSubsystem<UMayRecoilSubsystem>();
+		if (FMayRecoilState* State = RecoilSubsystem ? RecoilSubsystem->FindState(this) : nullptr)
+		{
+			State->AddPlayerYaw(Yaw, GetWorld()->GetDeltaSeconds());
+		}
+		return;
+	}
+
 	if (RecoilWorkerInstance)
 	{
 		RecoilWorkerInstance->OnYawAdded(Yaw);
@@ -65,18 +340,180 @@ void UMaySimpleRecoilComponent::OnYawAdded(float Yaw)
 
 void UMaySimpleRecoilComponent::OnPitchAdded(float Pitch)
 {
+	if (WorkerMode == EMayRecoilWorkerMode::Object)
+	{
+		if (RecoilWorkerObject)
+		{
+			RecoilWorkerObject->OnPitchAdded(Pitch);
+		}
+		return;
+	}
+
+	if (WorkerMode == EMayRecoilWorkerMode::Subsystem)
+	{
+		UMayRecoilSubsystem* RecoilSubsystem = GetWorld()->GetSubsystem<UMayRecoilSubsystem>();
+		if (FMayRecoilState* State = RecoilSubsystem ? RecoilSubsystem->FindState(this) : nullptr)
+		{
+			State->AddPlayerPitch(Pitch);
+		}
+		return;
+	}
+
 	if (RecoilWorkerInstance)
 	{
 		RecoilWorkerInstance->OnPitchAdded(Pitch);
 	}
 }
 
+FMayRecoilPackedState UMaySimpleRecoilComponent::GetPackedRecoilState() const
+{
+	if (WorkerMode != EMayRecoilWorkerMode::Actor)
+	{
+		UMayRecoilSubsystem* RecoilSubsystem = GetWorld()->GetSubsystem<UMayRecoilSubsystem>();
+		const FMayRecoilState* State = RecoilSubsystem ? RecoilSubsystem->FindState(this) : nullptr;
+		return State ? State->Pack() : FMayRecoilPackedState();
+	}
+
+	return RecoilWorkerInstance ? RecoilWorkerInstance->PackState() : FMayRecoilPackedState();
+}
+
+void UMaySimpleRecoilComponent::SetPackedRecoilState(const FMayRecoilPackedState& PackedState)
+{
+	if (WorkerMode != EMayRecoilWorkerMode::Actor)
+	{
+		if (UMayRecoilSubsystem* RecoilSubsystem = GetWorld()->GetSubsystem<UMayRecoilSubsystem>())
+		{
+			RecoilSubsystem->RestoreState(this, PackedState, GetEffectiveRecoilData());
+		}
+		return;
+	}
+
+	TrySpawnRecoilWorkerInstance();
+
+	if (RecoilWorkerInstance)
+	{
+		RecoilWorkerInstance->SetCurrentRecoilData(GetEffectiveRecoilData());
+		RecoilWorkerInstance->UnpackState(PackedState);
+	}
+}
+
+void UMaySimpleRecoilComponent::SetRecoilData(UMayRecoilData* NewRecoilData)
+{
+	RecoilData = NewRecoilData;
+	if (!HasBegunPlay()) return; // BeginPlay starts with RecoilData
+
+	// Setting the data is an equip event, the provider is asked again
+	InvalidateRecoilData();
+	UpdateRecoilData();
+}
+
+void UMaySimpleRecoilComponent::SwitchRecoilData(UMayRecoilData* NewRecoilData)
+{
+	if (NewRecoilData == ActiveRecoilData) return;
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	const FMayRecoilPackedState OutgoingState = GetPackedRecoilState();
+
+	// Cache the outgoing state, dropping the least recently used one if the cache is full
+	if (ActiveRecoilData && MaxCachedRecoilStates > 0)
+	{
+		if (CachedRecoilStates.Num() >= MaxCachedRecoilStates)
+		{
+			int32 OldestIndex = 0;
+			for (int32 Index = 1; Index < CachedRecoilStates.Num(); ++Index)
+			{
+				if (CachedRecoilStates[Index].CachedTime < CachedRecoilStates[OldestIndex].CachedTime)
+				{
+					OldestIndex = Index;
+				}
+			}
+			CachedRecoilStates.RemoveAtSwap(OldestIndex);
+		}
+
+		FMayRecoilCachedState& Cached = CachedRecoilStates.AddDefaulted_GetRef();
+		Cached.RecoilData = ActiveRecoilData;
+		Cached.State = OutgoingState;
+		Cached.CachedTime = Now;
+		Cached.ServerPatternIndex = ServerPatternIndex;
+		Cached.ServerLastShotTime = ServerLastShotTime;
+	}
+
+	ActiveRecoilData = NewRecoilData;
+
+	if (RecoilWorkerObject)
+	{
+		RecoilWorkerObject->SetCurrentRecoilData(GetEffectiveRecoilData());
+	}
+
+	// Restore the incoming state, decayed by the time it was not in use
+	FMayRecoilPackedState IncomingState;
+	ServerPatternIndex = 0;
+	ServerLastShotTime = -UE_BIG_NUMBER;
+
+	const int32 CachedIndex = CachedRecoilStates.IndexOfByPredicate([NewRecoilData](const FMayRecoilCachedState& Cached) { return Cached.RecoilData == NewRecoilData; });
+	if (CachedIndex != INDEX_NONE)
+	{
+		const FMayRecoilCachedState& Cached = CachedRecoilStates[CachedIndex];
+
+		FMayRecoilState DecayedState;
+		DecayedState.Unpack(Cached.State, GetEffectiveRecoilData());
+		DecayedState.Decay(Now - Cached.CachedTime);
+		IncomingState = DecayedState.Pack();
+
+		ServerPatternIndex = Cached.ServerPatternIndex;
+		ServerLastShotTime = Cached.ServerLastShotTime;
+		CachedRecoilStates.RemoveAtSwap(CachedIndex);
+	}
+
+	// The random stream belongs to the component, so the shot index continues across swaps
+	IncomingState.ShotIndex = OutgoingState.ShotIndex;
+
+	// An unpossessed pawn does not hold a worker and has no state to restore
+	if (NewRecoilData && (WorkerMode != EMayRecoilWorkerMode::Actor || RecoilWorkerInstance))
+	{
+		SetPackedRecoilState(IncomingState);
+	}
+}
+
 void UMaySimpleRecoilComponent::UpdatePlayerYawAndPitch_Implementation(float Yaw, float Pitch)
 {
-	if (CharacterOwner)
+	if (!CharacterOwner) return;
+
+	if (bApplyToControlRotation)
 	{
-		CharacterOwner->AddControllerYawInput(Yaw);
-		CharacterOwner->AddControllerPitchInput(Pitch);
+		AController* Controller = CharacterOwner->GetController();
+		if (!Controller) return;
+
+		// Negative pitch input looks up, same direction as AddControllerPitchInput
+		FRotator NewRotation = Controller->GetControlRotation();
+		NewRotation.Yaw += Yaw;
+		NewRotation.Pitch -= Pitch;
+
+		const APlayerController* PlayerController = Cast<APlayerController>(Controller);
+		if (PlayerController && PlayerController->PlayerCameraManager)
+		{
+			NewRotation.Pitch = FMath::ClampAngle(NewRotation.Pitch, PlayerController->PlayerCameraManager->ViewPitchMin, PlayerController->PlayerCameraManager->ViewPitchMax);
+		}
+
+		Controller->SetControlRotation(NewRotation.GetNormalized());
+		return;
+	}
+
+	CharacterOwner->AddControllerYawInput(Yaw);
+	CharacterOwner->AddControllerPitchInput(Pitch);
+}
+
+void UMaySimpleRecoilComponent::ApplyRecoilYawAndPitch(float Yaw, float Pitch)
+{
+	MAYRECOIL_SCOPE_CYCLE_COUNTER(STAT_MayRecoilUpdatePlayer);
+
+	if (bUpdatePlayerYawAndPitchInScript)
+	{
+		UpdatePlayerYawAndPitch(Yaw, Pitch);
+	}
+	else
+	{
+		UpdatePlayerYawAndPitch_Implementation(Yaw, Pitch);
 	}
 }
 
@@ -85,45 +522,100 @@ void UMaySimpleRecoilComponent::TrySetADS(bool bNewADS)
 	if (CanSwitchToADS_Implementation())
 	{
 		ADS = bNewADS;
+		InvalidateMovementState();
 	}
 }
 
-bool UMaySimpleRecoilComponent::IsSprinting_Implementation() const
+EMayRecoilMovementState UMaySimpleRecoilComponent::GetMovementState() const
 {
-	if (CharacterOwner)
+	if (MovementStateFrame != GFrameCounter)
 	{
-		return CharacterOwner->GetVelocity().Size() > SprintSpeedThreshold;
+		MovementState = BuildMovementState();
+		MovementStateFrame = GFrameCounter;
 	}
-	return false;
+	return MovementState;
 }
 
-bool UMaySimpleRecoilComponent::IsCrouching_Implementation() const
+void UMaySimpleRecoilComponent::InvalidateMovementState()
 {
-	return (CharacterOwner) ? CharacterOwner->bIsCrouched : false;
+	MovementStateFrame = MAX_uint64;
 }
 
-bool UMaySimpleRecoilComponent::IsJumping_Implementation() const
+void UMaySimpleRecoilComponent::SetCustomMovementState(EMayRecoilMovementState State, bool bActive)
 {
-	if (CharacterOwner && CharacterOwner->GetCharacterMovement())
+	// Only the custom bits can be set from outside
+	State &= EMayRecoilMovementState::Custom1 | EMayRecoilMovementState::Custom2 | EMayRecoilMovementState::Custom3;
+	if (bActive)
 	{
-		return CharacterOwner->GetCharacterMovement()->Velocity.Z > 0.0f && CharacterOwner->GetCharacterMovement()->IsFalling();
+		CustomMovementState |= State;
 	}
-	return false;
+	else
+	{
+		CustomMovementState &= ~State;
+	}
+	InvalidateMovementState();
 }
 
-bool UMaySimpleRecoilComponent::IsFalling_Implementation() const
+EMayRecoilMovementState UMaySimpleRecoilComponent::BuildMovementState() const
 {
-	if (CharacterOwner && CharacterOwner->GetCharacterMovement())
+	EMayRecoilMovementState State = CustomMovementState;
+	if (ADS)
+	{
+		State |= EMayRecoilMovementState::ADS;
+	}
+	if (!CharacterOwner) return State;
+
+	if (CharacterOwner->bIsCrouched)
+	{
+		State |= EMayRecoilMovementState::Crouch;
+	}
+
+	// Squared comparison, no sqrt
+	const FVector Velocity = CharacterOwner->GetVelocity();
+	if (Velocity.SizeSquared() > FMath::Square(SprintSpeedThreshold))
+	{
+		State |= EMayRecoilMovementState::Sprint;
+	}
+
+	const UCharacterMovementComponent* Movement = CharacterOwner->GetCharacterMovement();
+	if (Movement && Movement->IsFalling())
 	{
-		return CharacterOwner->GetCharacterMovement()->Velocity.Z < 0.0f && CharacterOwner->GetCharacterMovement()->IsFalling();
+		if (Movement->Velocity.Z > 0.0f)
+		{
+			State |= EMayRecoilMovementState::Jump;
+		}
+		else if (Movement->Velocity.Z < 0.0f)
+		{
+			State |= EMayRecoilMovementState::Fall;
+		}
 	}
-	return false;
+
+	return State;
+}
+
+bool UMaySimpleRecoilComponent::IsSprinting_Implementation() const
+{
+	return EnumHasAnyFlags(GetMovementState(), EMayRecoilMovementState::Sprint);
+}
+
+bool UMaySimpleRecoilComponent::IsCrouching_Implementation() const
+{
+	return EnumHasAnyFlags(GetMovementState(), EMayRecoilMovementState::Crouch);
+}
+
+bool UMaySimpleRecoilComponent::IsJumping_Implementation() const
+{
+	return EnumHasAnyFlags(GetMovementState(), EMayRecoilMovementState::Jump);
+}
+
+bool UMaySimpleRecoilComponent::IsFalling_Implementation() const
+{
+	return EnumHasAnyFlags(GetMovementState(), EMayRecoilMovementState::Fall);
 }
 
 bool UMaySimpleRecoilComponent::CanSwitchToADS_Implementation() const
 {
-	return !this->IsJumping_Implementation() &&
-		   !this->IsFalling_Implementation();
+	return !EnumHasAnyFlags(GetMovementState(), EMayRecoilMovementState::Jump | EMayRecoilMovementState::Fall);
 }
 
 bool UMaySimpleRecoilComponent::IsADS_Implementation() const
@@ -136,10 +628,10 @@ UMayRecoilData* UMaySimpleRecoilComponent::ProvideRecoilData_Implementation() co
 	// Standardimplementierung: rekursive Suche ab dem Owner
 	AActor* OwnerActor = GetOwner();
 	UMayRecoilData* LocalRecoilData = nullptr;
-	// if (OwnerActor)
-	// {
-	// 	LocalRecoilData = DefaultFindRecoilData(OwnerActor);
-	// }
+	if (OwnerActor)
+	{
+		LocalRecoilData = DefaultFindRecoilData(OwnerActor);
+	}
 	if (!LocalRecoilData)
 	{
 		if (RecoilData)
@@ -149,4 +641,166 @@ UMayRecoilData* UMaySimpleRecoilComponent::ProvideRecoilData_Implementation() co
 	}
 
 	return LocalRecoilData;
+}
+
+UMayRecoilData* UMaySimpleRecoilComponent::DefaultFindRecoilData(const AActor* Actor)
+{
+	if (!Actor) return nullptr;
+
+	if (Actor->Implements<UMayRecoilDataProvider>())
+	{
+		if (UMayRecoilData* Data = IMayRecoilDataProvider::Execute_ProvideRecoilData(Actor))
+		{
+			return Data;
+		}
+	}
+
+	// Recoil components are skipped, they would start the same search again
+	for (const UActorComponent* Component : Actor->GetComponents())
+	{
+		if (Component && !Component->IsA<UMaySimpleRecoilComponent>() && Component->Implements<UMayRecoilDataProvider>())
+		{
+			if (UMayRecoilData* Data = IMayRecoilDataProvider::Execute_ProvideRecoilData(Component))
+			{
+				return Data;
+			}
+		}
+	}
+
+	// Attached actors, e.g. the equipped weapon and its attachments
+	TArray<AActor*> AttachedActors;
+	Actor->GetAttachedActors(AttachedActors);
+	for (const AActor* AttachedActor : AttachedActors)
+	{
+		if (UMayRecoilData* Data = DefaultFindRecoilData(AttachedActor))
+		{
+			return Data;
+		}
+	}
+
+	return nullptr;
+}
+
+void UMaySimpleRecoilComponent::InvalidateRecoilData()
+{
+	bProvidedRecoilDataValid = false;
+}
+
+UMayRecoilData* UMaySimpleRecoilComponent::GetProvidedRecoilData()
+{
+	if (!bProvidedRecoilDataValid)
+	{
+		ProvidedRecoilData = IMayRecoilDataProvider::Execute_ProvideRecoilData(this);
+		bProvidedRecoilDataValid = true;
+	}
+	return ProvidedRecoilData;
+}
+
+UMayRecoilData* UMaySimpleRecoilComponent::UpdateRecoilData()
+{
+	// RecoilData was assigned directly instead of through SetRecoilData
+	if (RecoilData != ConfiguredRecoilData)
+	{
+		ConfiguredRecoilData = RecoilData;
+		InvalidateRecoilData();
+	}
+
+	SwitchRecoilData(GetProvidedRecoilData());
+	return GetEffectiveRecoilData();
+}
+
+FMayRecoilModifierStack* UMaySimpleRecoilComponent::FindRecoilModifierStack(const UMayRecoilData* ForRecoilData)
+{
+	return const_cast<FMayRecoilModifierStack*>(AsConst(*this).FindRecoilModifierStack(ForRecoilData));
+}
+
+const FMayRecoilModifierStack* UMaySimpleRecoilComponent::FindRecoilModifierStack(const UMayRecoilData* ForRecoilData) const
+{
+	// Before BeginPlay the active recoil data is not set yet
+	const UMayRecoilData* Key = ForRecoilData ? ForRecoilData : (ActiveRecoilData ? ActiveRecoilData : RecoilData);
+	if (!Key) return nullptr; // Recoil data must be valid
+
+	return RecoilModifierStacks.FindByPredicate([Key](const FMayRecoilModifierStack& Stack) { return Stack.RecoilData == Key; });
+}
+
+void UMaySimpleRecoilComponent::AddRecoilModifier(UMayRecoilModifierData* Modifier, UMayRecoilData* ForRecoilData)
+{
+	if (!Modifier) return; // Modifier must be valid
+
+	FMayRecoilModifierStack* Stack = FindRecoilModifierStack(ForRecoilData);
+	if (!Stack)
+	{
+		UMayRecoilData* Key = ForRecoilData ? ForRecoilData : (ActiveRecoilData ? ActiveRecoilData : RecoilData);
+		if (!Key) return; // Recoil data must be valid
+
+		Stack = &RecoilModifierStacks.AddDefaulted_GetRef();
+		Stack->RecoilData = Key;
+	}
+
+	Stack->Modifiers.Add(Modifier);
+	Stack->bCompiledValid = false;
+}
+
+void UMaySimpleRecoilComponent::RemoveRecoilModifier(UMayRecoilModifierData* Modifier, UMayRecoilData* ForRecoilData)
+{
+	FMayRecoilModifierStack* Stack = FindRecoilModifierStack(ForRecoilData);
+	if (Stack && Stack->Modifiers.RemoveSingle(Modifier) > 0)
+	{
+		Stack->bCompiledValid = false;
+	}
+}
+
+void UMaySimpleRecoilComponent::ClearRecoilModifiers(UMayRecoilData* ForRecoilData)
+{
+	if (FMayRecoilModifierStack* Stack = FindRecoilModifierStack(ForRecoilData))
+	{
+		Stack->Modifiers.Reset();
+		Stack->bCompiledValid = false;
+	}
+}
+
+TArray<UMayRecoilModifierData*> UMaySimpleRecoilComponent::GetRecoilModifiers(UMayRecoilData* ForRecoilData) const
+{
+	const FMayRecoilModifierStack* Stack = FindRecoilModifierStack(ForRecoilData);
+	return Stack ? Stack->Modifiers : TArray<UMayRecoilModifierData*>();
+}
+
+void UMaySimpleRecoilComponent::InvalidateRecoilModifiers()
+{
+	for (FMayRecoilModifierStack& Stack : RecoilModifierStacks)
+	{
+		Stack.bCompiledValid = false;
+	}
+}
+
+UMayRecoilData* UMaySimpleRecoilComponent::GetEffectiveRecoilData()
+{
+	if (!ActiveRecoilData) return nullptr; // ActiveRecoilData must be valid
+
+	FMayRecoilModifierStack* Stack = FindRecoilModifierStack(ActiveRecoilData);
+	if (!Stack || Stack->Modifiers.Num() == 0) return ActiveRecoilData;
+
+	// Compiled once per recoil data, switching back to a weapon reuses its compiled data
+	if (!Stack->bCompiledValid)
+	{
+		Stack->CompiledRecoilData = UMayRecoilModifierData::CompileRecoilData(ActiveRecoilData, Stack->Modifiers, this);
+		Stack->bCompiledValid = true;
+	}
+	return Stack->CompiledRecoilData;
+}
+
+float UMaySimpleRecoilComponent::CalculateRecoilScale(const UMayRecoilData* Data) const
+{
+	if (!Data) return 1.0f;
+
+	return Data->GetStateScale(GetMovementState());
+}
+
+void UMaySimpleRecoilComponent::CalculateRecoilYawAndPitchStrength(const UMayRecoilData* Data, float Scale, FRandomStream& Stream, int32 PatternShotIndex, float& OutYaw, float& OutPitch) const
+{
+	if (!Data) return;
+
+	const FVector2D YawAndPitch = FMayRecoilEvaluator::EvaluateShot(*Data, Scale, Stream, PatternShotIndex);
+	OutYaw = YawAndPitch.X;
+	OutPitch = YawAndPitch.Y;
 }
\ No newline at end of file
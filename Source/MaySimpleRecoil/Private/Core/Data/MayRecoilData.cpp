@@ -2,3 +2,113 @@
 
 
 #include "Core/Data/MayRecoilData.h"
+#include "Core/Settings/MayRecoilSettings.h"
+#include "Serialization/CustomVersion.h"
+
+const FGuid FMayRecoilDataCustomVersion::GUID(0xD9E32E68, 0x89634006, 0x8727D7A4, 0xB0F6C973);
+
+static FCustomVersionRegistration GRegisterMayRecoilDataCustomVersion(FMayRecoilDataCustomVersion::GUID, FMayRecoilDataCustomVersion::LatestVersion, TEXT("MayRecoilDataVer"));
+
+void FMayRecoilPatternTable::Bake(const TArray<FStaticPatternData>& Pattern)
+{
+	Points.Reset(Pattern.Num());
+	Jitter.Reset(Pattern.Num());
+
+	for (const FStaticPatternData& Shot : Pattern)
+	{
+		Points.Add(FVector2f(Shot.Point));
+		Jitter.Add(FVector4f(Shot.MinRecoilHorizontalStrength, Shot.MaxRecoilHorizontalStrength, Shot.MinRecoilVerticalStrength, Shot.MaxRecoilVerticalStrength));
+	}
+}
+
+void FMayRecoilScaleTable::Bake(float BaseScale, TConstArrayView<float> StateScales)
+{
+	const int32 NumStates = StateScales.Num();
+	Multipliers.SetNumUninitialized(1 << NumStates);
+
+	// Every entry is the entry without its highest bit times the scale of that bit
+	Multipliers[0] = BaseScale;
+	for (int32 StateIndex = 0; StateIndex < NumStates; ++StateIndex)
+	{
+		const int32 Bit = 1 << StateIndex;
+		for (int32 Index = 0; Index < Bit; ++Index)
+		{
+			Multipliers[Bit | Index] = Multipliers[Index] * StateScales[StateIndex];
+		}
+	}
+}
+
+void UMayRecoilData::RebuildBakedData()
+{
+	AddEasingTable.Bake(RecoilInterpolation, RecoilInterpolationEaseExp, RecoilInterpolationSteps);
+	ResetEasingTable.Bake(RecoilResetInterpolation, RecoilResetInterpolationEaseExp, RecoilResetInterpolationSteps);
+	PatternTable.Bake(StaticPattern);
+
+	// The project settings may not be available yet while the class default object is created
+	if (HasAnyFlags(RF_ClassDefaultObject)) return;
+
+	const UMayRecoilSettings* Settings = GetDefault<UMayRecoilSettings>();
+	const int32 NumCustomStates = Settings->GetNumCustomStates();
+
+	// Same order as the bits of EMayRecoilMovementState
+	TArray<float, TInlineAllocator<4 + UMayRecoilSettings::MaxCustomStates>> StateScales;
+	if (OverrideScaleSettings)
+	{
+		StateScales = { RecoilScaleCrouch, RecoilScaleSprint, RecoilScaleJump, RecoilScaleADS };
+		for (int32 Index = 0; Index < NumCustomStates; ++Index)
+		{
+			StateScales.Add(RecoilScaleCustom.IsValidIndex(Index) ? RecoilScaleCustom[Index] : Settings->CustomStates[Index].DefaultScale);
+		}
+	}
+	else
+	{
+		StateScales = { Settings->RecoilScaleCrouch, Settings->RecoilScaleSprint, Settings->RecoilScaleJump, Settings->RecoilScaleADS };
+		for (int32 Index = 0; Index < NumCustomStates; ++Index)
+		{
+			StateScales.Add(Settings->CustomStates[Index].DefaultScale);
+		}
+	}
+
+	ScaleTable.Bake(OverrideScaleSettings ? RecoilScale : Settings->RecoilScale, StateScales);
+}
+
+int32 UMayRecoilData::GetPatternTableIndex(int32 ShotIndex) const
+{
+	const int32 NumShots = PatternTable.Num();
+	if (!UseStaticPattern || NumShots == 0) return INDEX_NONE;
+
+	return LoopStaticPattern ? ShotIndex % NumShots : FMath::Min(ShotIndex, NumShots - 1);
+}
+
+void UMayRecoilData::PostInitProperties()
+{
+	Super::PostInitProperties();
+	RebuildBakedData();
+}
+
+void UMayRecoilData::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+	Ar.UsingCustomVersion(FMayRecoilDataCustomVersion::GUID);
+}
+
+void UMayRecoilData::PostLoad()
+{
+	Super::PostLoad();
+
+	// Assets saved before the project settings existed always used their own scales, keep them if they were customized
+	if (GetLinkerCustomVersion(FMayRecoilDataCustomVersion::GUID) < FMayRecoilDataCustomVersion::ScaleSettingsOverride && !OverrideScaleSettings)
+	{
+		OverrideScaleSettings = RecoilScale != 1.0f || RecoilScaleSprint != 2.0f || RecoilScaleCrouch != 0.25f || RecoilScaleJump != 1.0f || RecoilScaleADS != 1.0f;
+	}
+
+	RebuildBakedData();
+}
+
+#if WITH_EDITOR
+void UMayRecoilData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	RebuildBakedData();
+}
+#endif
@@ -0,0 +1,120 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/Data/MayRecoilModifierData.h"
+#include "Core/Data/MayRecoilData.h"
+#include "Core/Settings/MayRecoilSettings.h"
+
+/**
+ * @brief Compiles recoil data and a modifier stack into a flattened recoil data.
+ */
+UMayRecoilData* UMayRecoilModifierData::CompileRecoilData(const UMayRecoilData* BaseData, TConstArrayView<UMayRecoilModifierData*> ModifierData, UObject* Outer)
+{
+	if (!BaseData) return nullptr; // BaseData must be valid
+
+	// Sum of the Add and product of the Multiply modifiers of each field
+	constexpr int32 NumFields = static_cast<int32>(EMayRecoilModifierField::Num);
+	float Add[NumFields];
+	float Multiply[NumFields];
+	for (int32 Index = 0; Index < NumFields; ++Index)
+	{
+		Add[Index] = 0.0f;
+		Multiply[Index] = 1.0f;
+	}
+
+	for (const UMayRecoilModifierData* Data : ModifierData)
+	{
+		if (!Data) continue;
+
+		for (const FMayRecoilModifier& Modifier : Data->Modifiers)
+		{
+			const int32 Field = static_cast<int32>(Modifier.Field);
+			if (Field >= NumFields) continue;
+
+			if (Modifier.Op == EMayRecoilModifierOp::Add)
+			{
+				Add[Field] += Modifier.Value;
+			}
+			else
+			{
+				Multiply[Field] *= Modifier.Value;
+			}
+		}
+	}
+
+	auto Apply = [&Add, &Multiply](EMayRecoilModifierField Field, float Value)
+	{
+		return (Value + Add[static_cast<int32>(Field)]) * Multiply[static_cast<int32>(Field)];
+	};
+
+	// Strengths are signed (left and right, up and down), Add changes the magnitude and never flips the sign.
+	// Zero counts as positive, FMath::Sign(0) would keep a zero strength at zero whatever is added
+	auto ApplyMagnitude = [&Add, &Multiply](EMayRecoilModifierField Field, float Value)
+	{
+		const float Magnitude = FMath::Max(FMath::Abs(Value) + Add[static_cast<int32>(Field)], 0.0f);
+		const float Sign = Value < 0.0f ? -1.0f : 1.0f;
+		return Sign * Magnitude * Multiply[static_cast<int32>(Field)];
+	};
+
+	UMayRecoilData* Compiled = DuplicateObject<UMayRecoilData>(BaseData, Outer);
+	Compiled->SetFlags(RF_Transient);
+
+	auto ApplyVertical = [&ApplyMagnitude](float Value) { return ApplyMagnitude(EMayRecoilModifierField::VerticalStrength, Value); };
+	auto ApplyHorizontal = [&ApplyMagnitude](float Value) { return ApplyMagnitude(EMayRecoilModifierField::HorizontalStrength, Value); };
+
+	Compiled->MinRecoilVerticalStrength = ApplyVertical(BaseData->MinRecoilVerticalStrength);
+	Compiled->MaxRecoilVerticalStrength = ApplyVertical(BaseData->MaxRecoilVerticalStrength);
+	Compiled->MinRecoilHorizontalStrength = ApplyHorizontal(BaseData->MinRecoilHorizontalStrength);
+	Compiled->MaxRecoilHorizontalStrength = ApplyHorizontal(BaseData->MaxRecoilHorizontalStrength);
+
+	// The jitter is relative to the point of the shot, only the multipliers apply
+	const float VerticalJitter = Multiply[static_cast<int32>(EMayRecoilModifierField::VerticalStrength)];
+	const float HorizontalJitter = Multiply[static_cast<int32>(EMayRecoilModifierField::HorizontalStrength)];
+	for (FStaticPatternData& Shot : Compiled->StaticPattern)
+	{
+		Shot.Point.X = ApplyHorizontal(Shot.Point.X);
+		Shot.Point.Y = ApplyVertical(Shot.Point.Y);
+		Shot.MinRecoilVerticalStrength *= VerticalJitter;
+		Shot.MaxRecoilVerticalStrength *= VerticalJitter;
+		Shot.MinRecoilHorizontalStrength *= HorizontalJitter;
+		Shot.MaxRecoilHorizontalStrength *= HorizontalJitter;
+	}
+
+	// Scale modifiers need the scales in the data, start from the project settings the base data uses
+	bool bModifiesScale = false;
+	for (const EMayRecoilModifierField Field : { EMayRecoilModifierField::Scale, EMayRecoilModifierField::ScaleSprint, EMayRecoilModifierField::ScaleCrouch, EMayRecoilModifierField::ScaleJump, EMayRecoilModifierField::ScaleADS })
+	{
+		bModifiesScale |= Add[static_cast<int32>(Field)] != 0.0f || Multiply[static_cast<int32>(Field)] != 1.0f;
+	}
+
+	if (bModifiesScale && !BaseData->OverrideScaleSettings)
+	{
+		const UMayRecoilSettings* Settings = GetDefault<UMayRecoilSettings>();
+		Compiled->OverrideScaleSettings = true;
+		Compiled->RecoilScale = Settings->RecoilScale;
+		Compiled->RecoilScaleSprint = Settings->RecoilScaleSprint;
+		Compiled->RecoilScaleCrouch = Settings->RecoilScaleCrouch;
+		Compiled->RecoilScaleJump = Settings->RecoilScaleJump;
+		Compiled->RecoilScaleADS = Settings->RecoilScaleADS;
+		Compiled->RecoilScaleCustom.Reset();
+		for (int32 Index = 0; Index < Settings->GetNumCustomStates(); ++Index)
+		{
+			Compiled->RecoilScaleCustom.Add(Settings->CustomStates[Index].DefaultScale);
+		}
+	}
+
+	if (bModifiesScale)
+	{
+		Compiled->RecoilScale = FMath::Max(Apply(EMayRecoilModifierField::Scale, Compiled->RecoilScale), 0.0f);
+		Compiled->RecoilScaleSprint = FMath::Max(Apply(EMayRecoilModifierField::ScaleSprint, Compiled->RecoilScaleSprint), 0.0f);
+		Compiled->RecoilScaleCrouch = FMath::Max(Apply(EMayRecoilModifierField::ScaleCrouch, Compiled->RecoilScaleCrouch), 0.0f);
+		Compiled->RecoilScaleJump = FMath::Max(Apply(EMayRecoilModifierField::ScaleJump, Compiled->RecoilScaleJump), 0.0f);
+		Compiled->RecoilScaleADS = FMath::Max(Apply(EMayRecoilModifierField::ScaleADS, Compiled->RecoilScaleADS), 0.0f);
+	}
+
+	Compiled->RecoilSpeed = FMath::Max(Apply(EMayRecoilModifierField::RecoilSpeed, BaseData->RecoilSpeed), 0.0f);
+	Compiled->RecoilResetDelay = FMath::Max(Apply(EMayRecoilModifierField::ResetDelay, BaseData->RecoilResetDelay), 0.0f);
+	Compiled->RecoilResetSpeed = FMath::Max(Apply(EMayRecoilModifierField::ResetSpeed, BaseData->RecoilResetSpeed), 0.0f);
+
+	Compiled->RebuildBakedData();
+	return Compiled;
+}
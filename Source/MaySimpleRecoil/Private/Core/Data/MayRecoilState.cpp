@@ -0,0 +1,436 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/Data/MayRecoilState.h"
+#include "Core/Data/MayRecoilData.h"
+#include "Core/Impl/MayRecoilEvaluator.h"
+#include "Core/Settings/MayRecoilSettings.h"
+#include "MayRecoilStats.h"
+
+// ============================================================================
+// Random
+// ============================================================================
+
+/**
+ * @brief Reseeds the stream for the next shot and advances the shot index.
+ */
+FRandomStream& FMayRecoilRandom::NextShot(int32 InSeed)
+{
+	Seed = InSeed;
+	Stream.Initialize(static_cast<int32>(HashCombine(GetTypeHash(Seed), GetTypeHash(ShotIndex))));
+	++ShotIndex;
+	return Stream;
+}
+
+/**
+ * @brief Continues the stream and the static pattern after a server correction.
+ */
+void FMayRecoilRandom::ApplyCorrection(int32 NextShotIndex, int32 NextPatternIndex, int32& InOutPatternIndex)
+{
+	const int32 NumShotsAhead = ShotIndex - NextShotIndex;
+	if (NumShotsAhead <= 0)
+	{
+		// No shot fired since the corrected one
+		ShotIndex = NextShotIndex;
+		InOutPatternIndex = NextPatternIndex;
+		return;
+	}
+
+	// Fewer pattern shots than shots since the corrected one: the spray was reset in between, the pattern already restarted
+	if (InOutPatternIndex >= NumShotsAhead)
+	{
+		InOutPatternIndex = NextPatternIndex + NumShotsAhead;
+	}
+}
+
+// ============================================================================
+// Simulation
+// ============================================================================
+
+/**
+ * @brief Starts applying the recoil of a new shot.
+ *
+ * Equivalent to AMayRecoilWorker::Recoil_Implementation: any running add or reset
+ * phase is stopped and the add phase restarts from zero.
+ */
+void FMayRecoilState::Fire(UMayRecoilData* InRecoilData, float Yaw, float Pitch)
+{
+	RecoilData = InRecoilData;
+	if (!RecoilData) return; // RecoilData must be valid
+
+	if (RecoilData->AccumulateShots)
+	{
+		// Superimpose the shot on the ones in flight instead of restarting the add phase
+		if (Phase != EMayRecoilPhase::Adding)
+		{
+			ResetPitchOffset = 0.0f;
+			ResetDelayRemaining = 0.0f;
+			Phase = EMayRecoilPhase::Adding;
+		}
+		ShotYawAndPitch = FVector2D(Yaw, Pitch);
+		ShotAccumulator.Queue(ShotYawAndPitch);
+		++PatternIndex;
+		return;
+	}
+
+	ShotAccumulator.Reset();
+	ShotYawAndPitch = FVector2D(Yaw, Pitch);
+	AppliedYawAndPitch = FVector2D::ZeroVector;
+	ResetPitchOffset = 0.0f;
+	ResetDelayRemaining = 0.0f;
+	Alpha = 0.0f;
+	Phase = EMayRecoilPhase::Adding;
+	++PatternIndex;
+}
+
+/**
+ * @brief Advances the state by the given time.
+ *
+ * Runs the add phase, the reset delay and the reset phase the same way the worker
+ * timelines and the retriggerable delay do.
+ */
+FVector2D FMayRecoilState::Advance(float DeltaTime)
+{
+	if (!RecoilData)
+	{
+		Phase = EMayRecoilPhase::Idle;
+		return FVector2D::ZeroVector;
+	}
+
+	// Add and reset phase, eased one state at a time
+	FMayRecoilEasing Easing;
+	if (BeginEasedStep(DeltaTime, Easing))
+	{
+		return FinishEasedStep(Easing.Ease(Alpha));
+	}
+
+	FVector2D Delta = FVector2D::ZeroVector;
+
+	switch (Phase)
+	{
+	case EMayRecoilPhase::Adding:
+		{
+			// Shots in flight of the accumulating mode
+			Delta = ShotAccumulator.Advance(*RecoilData, DeltaTime);
+			AddedPitchAndYaw += Delta;
+
+			if (!ShotAccumulator.IsActive())
+			{
+				Phase = EMayRecoilPhase::WaitingForReset;
+				ResetDelayRemaining = RecoilData->RecoilResetDelay;
+			}
+			break;
+		}
+	case EMayRecoilPhase::WaitingForReset:
+		{
+			ResetDelayRemaining -= DeltaTime;
+			if (ResetDelayRemaining <= 0.0f)
+			{
+				// The spray is over, the next shot starts the static pattern from the beginning
+				PatternIndex = 0;
+
+				if (bDeferReset)
+				{
+					// The owner starts the reset, see ConsumeResetDue
+					Phase = EMayRecoilPhase::Idle;
+					bResetDue = true;
+					break;
+				}
+				BeginReset();
+			}
+			break;
+		}
+	default:
+		break;
+	}
+
+	return Delta;
+}
+
+/**
+ * @brief Advances the progress of the add or reset phase, the first half of Advance.
+ *
+ * Shots in flight of the accumulating mode ease their own alphas and are advanced by Advance.
+ */
+bool FMayRecoilState::BeginEasedStep(float DeltaTime, FMayRecoilEasing& OutEasing)
+{
+	if (!RecoilData) return false; // RecoilData must be valid
+
+	if (Phase == EMayRecoilPhase::Adding && !ShotAccumulator.IsActive())
+	{
+		Alpha = FMath::Min(Alpha + DeltaTime * RecoilData->RecoilSpeed, 1.0f);
+		OutEasing = FMayRecoilEvaluator::GetAddEasing(*RecoilData);
+		return true;
+	}
+	if (Phase == EMayRecoilPhase::Resetting)
+	{
+		Alpha = FMath::Min(Alpha + DeltaTime * RecoilData->RecoilResetSpeed, 1.0f);
+		OutEasing = FMayRecoilEvaluator::GetResetEasing(*RecoilData);
+		return true;
+	}
+	return false;
+}
+
+/**
+ * @brief Applies the eased alpha of the step started with BeginEasedStep, the second half of Advance.
+ */
+FVector2D FMayRecoilState::FinishEasedStep(float EasedAlpha)
+{
+	if (Phase == EMayRecoilPhase::Adding)
+	{
+		const FVector2D Eased = ShotYawAndPitch * EasedAlpha;
+
+		const FVector2D Delta = Eased - AppliedYawAndPitch;
+		AddedPitchAndYaw += Delta;
+		AppliedYawAndPitch = Eased;
+
+		if (Alpha >= 1.0f)
+		{
+			Phase = EMayRecoilPhase::WaitingForReset;
+			ResetDelayRemaining = RecoilData->RecoilResetDelay;
+		}
+		return Delta;
+	}
+
+	const FVector2D Eased = ResetFromPitchAndYaw * EasedAlpha;
+
+	const FVector2D Step = Eased - AppliedYawAndPitch;
+	AddedPitchAndYaw -= Step;
+	AppliedYawAndPitch = Eased;
+
+	if (Alpha >= 1.0f)
+	{
+		Phase = EMayRecoilPhase::Idle;
+	}
+	return Step * -1.0f;
+}
+
+/**
+ * @brief Advances the state in fixed steps up to the given time.
+ *
+ * An idle state only moves its clock, so a state that becomes active again does not catch up on the idle time.
+ */
+FVector2D FMayRecoilState::AdvanceFixed(double Time, float StepRate, int32 MaxSteps)
+{
+	const int32 NumSteps = StepClock.Consume(Time, StepRate, MaxSteps);
+	const float StepTime = 1.0f / StepRate;
+
+	FVector2D Delta = FVector2D::ZeroVector;
+	for (int32 Step = 0; Step < NumSteps && IsActive(); ++Step)
+	{
+		Delta += Advance(StepTime);
+	}
+	return Delta;
+}
+
+/**
+ * @brief Starts resetting the accumulated recoil if reset is enabled.
+ */
+void FMayRecoilState::BeginReset()
+{
+	if (!RecoilData || !RecoilData->RecoilResetRecoil)
+	{
+		Phase = EMayRecoilPhase::Idle;
+		return;
+	}
+
+	AppliedYawAndPitch = FVector2D::ZeroVector;
+	ResetFromPitchAndYaw = AddedPitchAndYaw;
+	Alpha = 0.0f;
+	Phase = EMayRecoilPhase::Resetting;
+}
+
+/**
+ * @brief Immediately clears the state.
+ */
+void FMayRecoilState::Clear()
+{
+	Phase = EMayRecoilPhase::Idle;
+	bResetDue = false;
+	ShotAccumulator.Reset();
+	PatternIndex = 0;
+	Alpha = 0.0f;
+	ResetDelayRemaining = 0.0f;
+	ResetPitchOffset = 0.0f;
+	AddedPitchAndYaw = FVector2D::ZeroVector;
+	ResetFromPitchAndYaw = FVector2D::ZeroVector;
+}
+
+/**
+ * @brief Applies a server correction.
+ *
+ * The delta is added to the accumulated recoil, so the reset also takes it back.
+ */
+void FMayRecoilState::ApplyCorrection(int32 NextShotIndex, int32 NextPatternIndex, const FVector2D& Delta)
+{
+	Random.ApplyCorrection(NextShotIndex, NextPatternIndex, PatternIndex);
+	AddedPitchAndYaw += Delta;
+}
+
+// ============================================================================
+// Packing
+// ============================================================================
+
+/**
+ * @brief Quantizes the state for replication, snapshots or save games.
+ */
+FMayRecoilPackedState FMayRecoilState::Pack() const
+{
+	using namespace MayRecoilNet;
+
+	FVector2D PackedShot = ShotYawAndPitch;
+	float PackedAlpha = Alpha;
+
+	if (Phase == EMayRecoilPhase::Adding && ShotAccumulator.IsActive() && RecoilData)
+	{
+		// Remaining recoil of all shots in flight, continued as one shot from the start
+		PackedShot = ShotAccumulator.PendingYawAndPitch;
+		for (const FMayRecoilShotAccumulator::FShot& Shot : ShotAccumulator.Shots)
+		{
+			PackedShot += Shot.YawAndPitch * (1.0f - FMayRecoilEvaluator::EaseAlpha(RecoilData->AddEasingTable, Shot.Alpha, RecoilData->RecoilInterpolation, RecoilData->RecoilInterpolationEaseExp, RecoilData->RecoilInterpolationSteps));
+		}
+		PackedAlpha = 0.0f;
+	}
+
+	FMayRecoilPackedState Packed;
+	Packed.Phase = static_cast<uint8>(Phase);
+	Packed.Alpha = QuantizeUnit(PackedAlpha);
+	Packed.ResetDelayRemaining = QuantizeTime(ResetDelayRemaining);
+	Packed.ShotYaw = QuantizeAngle(PackedShot.X);
+	Packed.ShotPitch = QuantizeAngle(PackedShot.Y);
+	Packed.AddedYaw = QuantizeAngle(AddedPitchAndYaw.X);
+	Packed.AddedPitch = QuantizeAngle(AddedPitchAndYaw.Y);
+	Packed.ResetFromYaw = QuantizeAngle(ResetFromPitchAndYaw.X);
+	Packed.ResetFromPitch = QuantizeAngle(ResetFromPitchAndYaw.Y);
+	Packed.ResetPitchOffset = QuantizeAngle(ResetPitchOffset);
+	Packed.ShotIndex = Random.ShotIndex;
+	Packed.PatternIndex = PatternIndex;
+	return Packed;
+}
+
+/**
+ * @brief Restores the state from a packed state.
+ *
+ * The yaw and pitch already applied in the current phase is recomputed from the progress.
+ */
+void FMayRecoilState::Unpack(const FMayRecoilPackedState& Packed, UMayRecoilData* InRecoilData)
+{
+	using namespace MayRecoilNet;
+
+	RecoilData = InRecoilData;
+	ShotAccumulator.Reset();
+
+	Phase = static_cast<EMayRecoilPhase>(Packed.Phase);
+	Alpha = DequantizeUnit(Packed.Alpha);
+	ResetDelayRemaining = DequantizeTime(Packed.ResetDelayRemaining);
+	ShotYawAndPitch = FVector2D(DequantizeAngle(Packed.ShotYaw), DequantizeAngle(Packed.ShotPitch));
+	AddedPitchAndYaw = FVector2D(DequantizeAngle(Packed.AddedYaw), DequantizeAngle(Packed.AddedPitch));
+	ResetFromPitchAndYaw = FVector2D(DequantizeAngle(Packed.ResetFromYaw), DequantizeAngle(Packed.ResetFromPitch));
+	ResetPitchOffset = DequantizeAngle(Packed.ResetPitchOffset);
+	Random.ShotIndex = Packed.ShotIndex;
+	PatternIndex = Packed.PatternIndex;
+
+	AppliedYawAndPitch = FVector2D::ZeroVector;
+	if (RecoilData && Phase == EMayRecoilPhase::Adding)
+	{
+		AppliedYawAndPitch = FMayRecoilEvaluator::EvaluateAdd(*RecoilData, ShotYawAndPitch, Alpha);
+	}
+	else if (RecoilData && Phase == EMayRecoilPhase::Resetting)
+	{
+		AppliedYawAndPitch = FMayRecoilEvaluator::EvaluateReset(*RecoilData, ResetFromPitchAndYaw, Alpha);
+	}
+}
+
+/**
+ * @brief Advances the state by a longer time without applying anything.
+ */
+void FMayRecoilState::Decay(float Time)
+{
+	// Every step ends a phase or uses up the time, the cap only guards against a phase that never ends
+	constexpr int32 MaxSteps = 16;
+	for (int32 Step = 0; Step < MaxSteps && Time > 0.0f && IsActive(); ++Step)
+	{
+		const float Remaining = GetPhaseTimeRemaining();
+		if (Time < Remaining)
+		{
+			Advance(Time);
+			return;
+		}
+
+		// The phase fits, advancing by all the time clamps it to complete where Alpha + Remaining * Speed may round below 1
+		Advance(Time);
+		Time -= Remaining;
+	}
+}
+
+/**
+ * @brief Returns the time until the current phase ends.
+ */
+float FMayRecoilState::GetPhaseTimeRemaining() const
+{
+	if (!RecoilData) return 0.0f;
+
+	switch (Phase)
+	{
+	case EMayRecoilPhase::Adding:
+		{
+			if (RecoilData->RecoilSpeed <= 0.0f) return UE_BIG_NUMBER;
+
+			// The slowest shot in flight decides, pending shots have not started yet
+			float Remaining = ShotAccumulator.IsActive() ? 0.0f : 1.0f - Alpha;
+			if (ShotAccumulator.bHasPending)
+			{
+				Remaining = 1.0f;
+			}
+			for (const FMayRecoilShotAccumulator::FShot& Shot : ShotAccumulator.Shots)
+			{
+				Remaining = FMath::Max(Remaining, 1.0f - Shot.Alpha);
+			}
+			return Remaining / RecoilData->RecoilSpeed;
+		}
+	case EMayRecoilPhase::WaitingForReset:
+		return FMath::Max(ResetDelayRemaining, 0.0f);
+	case EMayRecoilPhase::Resetting:
+		return RecoilData->RecoilResetSpeed > 0.0f ? (1.0f - Alpha) / RecoilData->RecoilResetSpeed : UE_BIG_NUMBER;
+	default:
+		return 0.0f;
+	}
+}
+
+/**
+ * @brief Handles yaw input added by the player.
+ *
+ * Decays the accumulated yaw back to zero (see AMayRecoilWorker::OnYawAdded_Implementation).
+ */
+void FMayRecoilState::AddPlayerYaw(float Yaw, float DeltaTime)
+{
+	if (Yaw == 0.0f) return; // Validate input
+
+	// Exponential, so the decay over a time span does not depend on the number of frames
+	AddedPitchAndYaw.X *= FMath::Exp(-GetDefault<UMayRecoilSettings>()->PlayerYawRecoverySpeed * DeltaTime);
+}
+
+/**
+ * @brief Handles pitch input added by the player.
+ *
+ * Mirrors AMayRecoilWorker::OnPitchAdded_Implementation: positive pitch reduces the accumulated
+ * recoil, pulling down against a running reset restarts the reset.
+ */
+void FMayRecoilState::AddPlayerPitch(float Pitch)
+{
+	if (Pitch > 0.0f)
+	{
+		// Add pitch but do not exceed 0.0f (to prevent over-rotation)
+		AddedPitchAndYaw.Y = FMath::Min(AddedPitchAndYaw.Y + Pitch, 0.0f);
+	}
+
+	if (Phase == EMayRecoilPhase::Resetting && Pitch < 0.0f)
+	{
+		ResetPitchOffset += FMath::Abs(Pitch);
+		if (ResetPitchOffset >= FMath::Abs(ResetFromPitchAndYaw.Y) * 1.1)
+		{
+			INC_DWORD_STAT(STAT_MayRecoilResetRestarts);
+			BeginReset();
+			ResetPitchOffset = 0.0f;
+		}
+	}
+}
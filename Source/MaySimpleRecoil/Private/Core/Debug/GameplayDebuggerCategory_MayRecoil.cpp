@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/Debug/GameplayDebuggerCategory_MayRecoil.h"
+
+#if WITH_GAMEPLAY_DEBUGGER
+
+#include "Components/MaySimpleRecoilComponent.h"
+#include "Core/Data/MayRecoilData.h"
+#include "Core/Impl/MayRecoilWorker.h"
+#include "Core/Subsystem/MayRecoilSubsystem.h"
+#include "GameFramework/PlayerController.h"
+
+FGameplayDebuggerCategory_MayRecoil::FGameplayDebuggerCategory_MayRecoil()
+{
+	bShowOnlyWithDebugActor = false;
+}
+
+TSharedRef<FGameplayDebuggerCategory> FGameplayDebuggerCategory_MayRecoil::MakeInstance()
+{
+	return MakeShareable(new FGameplayDebuggerCategory_MayRecoil());
+}
+
+void FGameplayDebuggerCategory_MayRecoil::CollectData(APlayerController* OwnerPC, AActor* DebugActor)
+{
+	// Fall back to the own pawn if nothing is selected
+	AActor* TargetActor = DebugActor ? DebugActor : (OwnerPC ? OwnerPC->GetPawn() : nullptr);
+	const UMaySimpleRecoilComponent* Component = TargetActor ? TargetActor->FindComponentByClass<UMaySimpleRecoilComponent>() : nullptr;
+	if (!Component)
+	{
+		AddTextLine(TEXT("{red}No MaySimpleRecoilComponent"));
+		return;
+	}
+
+	AddTextLine(FString::Printf(TEXT("{yellow}Recoil Data: {white}%s {yellow}Modifiers: {white}%d"), *GetNameSafe(Component->GetActiveRecoilData()), Component->GetRecoilModifiers().Num()));
+	const EMayRecoilMovementState MovementState = Component->GetMovementState();
+	AddTextLine(FString::Printf(TEXT("{yellow}State: {white}%s%s%s%s%s"),
+		EnumHasAnyFlags(MovementState, EMayRecoilMovementState::Crouch) ? TEXT("Crouch ") : TEXT(""),
+		EnumHasAnyFlags(MovementState, EMayRecoilMovementState::Sprint) ? TEXT("Sprint ") : TEXT(""),
+		EnumHasAnyFlags(MovementState, EMayRecoilMovementState::Jump) ? TEXT("Jump ") : TEXT(""),
+		EnumHasAnyFlags(MovementState, EMayRecoilMovementState::Fall) ? TEXT("Fall ") : TEXT(""),
+		EnumHasAnyFlags(MovementState, EMayRecoilMovementState::ADS) ? TEXT("ADS") : TEXT("")));
+
+	if (Component->WorkerMode != EMayRecoilWorkerMode::Actor)
+	{
+		UMayRecoilSubsystem* RecoilSubsystem = Component->GetWorld()->GetSubsystem<UMayRecoilSubsystem>();
+		const FMayRecoilState* State = RecoilSubsystem ? RecoilSubsystem->FindState(Component) : nullptr;
+		if (!State)
+		{
+			AddTextLine(TEXT("{red}Not registered at the recoil subsystem"));
+			return;
+		}
+
+		AddTextLine(FString::Printf(TEXT("{yellow}Phase: {white}%s  {yellow}Alpha: {white}%.2f  {yellow}Reset Delay: {white}%.2f"),
+			*UEnum::GetDisplayValueAsText(State->Phase).ToString(), State->Alpha, FMath::Max(State->ResetDelayRemaining, 0.0f)));
+		AddTextLine(FString::Printf(TEXT("{yellow}Shot Yaw/Pitch: {white}%.3f %.3f"), State->ShotYawAndPitch.X, State->ShotYawAndPitch.Y));
+		AddTextLine(FString::Printf(TEXT("{yellow}Added Yaw/Pitch: {white}%.3f %.3f"), State->AddedPitchAndYaw.X, State->AddedPitchAndYaw.Y));
+		AddTextLine(FString::Printf(TEXT("{yellow}Active States: {white}%d"), RecoilSubsystem->GetNumActiveStates()));
+		return;
+	}
+
+	const AMayRecoilWorker* Worker = Component->RecoilWorkerInstance;
+	if (!Worker)
+	{
+		AddTextLine(TEXT("{red}No recoil worker spawned"));
+		return;
+	}
+
+	AddTextLine(FString::Printf(TEXT("{yellow}Worker: {white}%s  {yellow}Ticking: {white}%s"),
+		*Worker->GetName(), Worker->IsActorTickEnabled() ? TEXT("yes") : TEXT("no")));
+	AddTextLine(FString::Printf(TEXT("{yellow}Add: {white}%s %.2f  {yellow}Reset: {white}%s %.2f  {yellow}Mode: {white}%s"),
+		Worker->IsAddRecoilPlaying() ? TEXT("playing") : TEXT("stopped"), Worker->GetAddRecoilPosition(),
+		Worker->IsResetRecoilPlaying() ? TEXT("playing") : TEXT("stopped"), Worker->GetResetRecoilPosition(),
+		*UEnum::GetDisplayValueAsText(Worker->EvaluationMode).ToString()));
+	AddTextLine(FString::Printf(TEXT("{yellow}Shot Yaw/Pitch: {white}%.3f %.3f"), Worker->GetCurrentOutYawAndPitch().X, Worker->GetCurrentOutYawAndPitch().Y));
+	AddTextLine(FString::Printf(TEXT("{yellow}Added Yaw/Pitch: {white}%.3f %.3f"), Worker->GetAddedPitchAndYaw().X, Worker->GetAddedPitchAndYaw().Y));
+	AddTextLine(FString::Printf(TEXT("{yellow}Temp Added Yaw/Pitch: {white}%.3f %.3f"), Worker->TempAddedYaw, Worker->TempAddedPitch));
+}
+
+#endif // WITH_GAMEPLAY_DEBUGGER
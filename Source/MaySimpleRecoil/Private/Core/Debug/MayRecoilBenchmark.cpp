@@ -0,0 +1,153 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/Debug/MayRecoilDebug.h"
+
+#if MAYRECOIL_DEBUG
+
+#include "Core/Data/MayRecoilData.h"
+#include "Core/Impl/MayRecoilEvaluator.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Kismet/KismetMathLibrary.h"
+
+namespace MayRecoilBenchmark
+{
+	/**
+	 * Compares the baked easing tables against UKismetMathLibrary::Ease for every easing function.
+	 * Logs the maximum absolute error and the cost per evaluation of both paths.
+	 */
+	static void BenchmarkEasing(const TArray<FString>& Args)
+	{
+		const int32 NumEvaluations = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1000000;
+		constexpr float BlendExp = 2.0f;
+		constexpr int32 Steps = 4;
+
+		UE_LOG(LogTemp, Display, TEXT("MayRecoil easing benchmark, %d evaluations per function"), NumEvaluations);
+
+		const UEnum* EasingEnum = StaticEnum<EEasingFunc::Type>();
+		for (int32 EnumIndex = 0; EnumIndex < EasingEnum->NumEnums() - 1; ++EnumIndex)
+		{
+			const EEasingFunc::Type EasingFunc = static_cast<EEasingFunc::Type>(EasingEnum->GetValueByIndex(EnumIndex));
+
+			FMayRecoilEasingTable Table;
+			Table.Bake(EasingFunc, BlendExp, Steps);
+
+			// Accuracy
+			float MaxError = 0.0f;
+			for (int32 Index = 0; Index <= 1000; ++Index)
+			{
+				const float Alpha = Index / 1000.0f;
+				const float Reference = UKismetMathLibrary::Ease(0.0f, 1.0f, Alpha, EasingFunc, BlendExp, Steps);
+				const float Baked = FMayRecoilEvaluator::EaseAlpha(Table, Alpha, EasingFunc, BlendExp, Steps);
+				MaxError = FMath::Max(MaxError, FMath::Abs(Reference - Baked));
+			}
+
+			// Cost, yaw and pitch like the worker did before
+			double Sink = 0.0;
+			const double EaseStart = FPlatformTime::Seconds();
+			for (int32 Index = 0; Index < NumEvaluations; ++Index)
+			{
+				const float Alpha = (Index & 1023) / 1023.0f;
+				Sink += UKismetMathLibrary::Ease(0.0f, 1.5f, Alpha, EasingFunc, BlendExp, Steps);
+				Sink += UKismetMathLibrary::Ease(0.0f, -2.0f, Alpha, EasingFunc, BlendExp, Steps);
+			}
+			const double EaseSeconds = FPlatformTime::Seconds() - EaseStart;
+
+			const double TableStart = FPlatformTime::Seconds();
+			for (int32 Index = 0; Index < NumEvaluations; ++Index)
+			{
+				const float Alpha = (Index & 1023) / 1023.0f;
+				const float Eased = FMayRecoilEvaluator::EaseAlpha(Table, Alpha, EasingFunc, BlendExp, Steps);
+				Sink += 1.5f * Eased;
+				Sink += -2.0f * Eased;
+			}
+			const double TableSeconds = FPlatformTime::Seconds() - TableStart;
+
+			UE_LOG(LogTemp, Display, TEXT("  %-16s baked: %-3s %s max error: %.6f  Ease: %.2f ns  Table: %.2f ns  (%.2fx)  [%f]"),
+				*EasingEnum->GetNameStringByIndex(EnumIndex),
+				Table.bBaked ? TEXT("yes") : TEXT("no"),
+				MaxError <= FMayRecoilEasingTable::MaxBakeError ? TEXT("PASS") : TEXT("FAIL"),
+				MaxError,
+				EaseSeconds * 1.0e9 / NumEvaluations,
+				TableSeconds * 1.0e9 / NumEvaluations,
+				TableSeconds > 0.0 ? EaseSeconds / TableSeconds : 0.0,
+				Sink);
+		}
+	}
+
+	static FAutoConsoleCommand BenchmarkEasingCommand(
+		TEXT("MayRecoil.Benchmark.Easing"),
+		TEXT("Compares accuracy and cost of the baked recoil easing tables against UKismetMathLibrary::Ease. Usage: MayRecoil.Benchmark.Easing [NumEvaluations]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkEasing));
+
+	/**
+	 * Compares the cost of FMayRecoilEvaluator::EaseAlphaBatch against the scalar EaseAlpha for every easing function,
+	 * e.g. the add alphas of many characters. Logs the cost per alpha of both paths, the accuracy is covered by the
+	 * MayRecoil.Easing.Batch automation test.
+	 */
+	static void BenchmarkEasingBatch(const TArray<FString>& Args)
+	{
+		const int32 NumCharacters = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1000;
+		const int32 NumIterations = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 1000;
+		constexpr float BlendExp = 2.0f;
+		constexpr int32 Steps = 4;
+
+		UE_LOG(LogTemp, Display, TEXT("MayRecoil easing batch benchmark, %d characters, %d iterations per function"), NumCharacters, NumIterations);
+
+		TArray<float> CharacterAlphas;
+		TArray<float> CharacterEased;
+		CharacterAlphas.SetNumUninitialized(NumCharacters);
+		CharacterEased.SetNumUninitialized(NumCharacters);
+		for (int32 Index = 0; Index < NumCharacters; ++Index)
+		{
+			CharacterAlphas[Index] = (Index & 1023) / 1023.0f;
+		}
+
+		const UEnum* EasingEnum = StaticEnum<EEasingFunc::Type>();
+		for (int32 EnumIndex = 0; EnumIndex < EasingEnum->NumEnums() - 1; ++EnumIndex)
+		{
+			const EEasingFunc::Type EasingFunc = static_cast<EEasingFunc::Type>(EasingEnum->GetValueByIndex(EnumIndex));
+
+			// Cost, yaw and pitch of every character
+			double Sink = 0.0;
+			const double ScalarStart = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				for (int32 Index = 0; Index < NumCharacters; ++Index)
+				{
+					const float Eased = FMayRecoilEvaluator::EaseAlpha(CharacterAlphas[Index], EasingFunc, BlendExp, Steps);
+					Sink += 1.5f * Eased;
+					Sink += -2.0f * Eased;
+				}
+			}
+			const double ScalarSeconds = FPlatformTime::Seconds() - ScalarStart;
+
+			const double BatchStart = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				FMayRecoilEvaluator::EaseAlphaBatch(CharacterAlphas, CharacterEased, EasingFunc, BlendExp, Steps);
+				for (int32 Index = 0; Index < NumCharacters; ++Index)
+				{
+					Sink += 1.5f * CharacterEased[Index];
+					Sink += -2.0f * CharacterEased[Index];
+				}
+			}
+			const double BatchSeconds = FPlatformTime::Seconds() - BatchStart;
+
+			const double NumEvaluations = static_cast<double>(NumCharacters) * NumIterations;
+			UE_LOG(LogTemp, Display, TEXT("  %-16s Scalar: %.2f ns  Batch: %.2f ns  (%.2fx)  [%f]"),
+				*EasingEnum->GetNameStringByIndex(EnumIndex),
+				ScalarSeconds * 1.0e9 / NumEvaluations,
+				BatchSeconds * 1.0e9 / NumEvaluations,
+				BatchSeconds > 0.0 ? ScalarSeconds / BatchSeconds : 0.0,
+				Sink);
+		}
+	}
+
+	static FAutoConsoleCommand BenchmarkEasingBatchCommand(
+		TEXT("MayRecoil.Benchmark.EasingBatch"),
+		TEXT("Compares the cost of the vectorized recoil easing against the scalar one. Usage: MayRecoil.Benchmark.EasingBatch [NumCharacters] [NumIterations]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkEasingBatch));
+}
+
+#endif
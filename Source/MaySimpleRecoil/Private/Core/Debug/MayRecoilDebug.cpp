@@ -0,0 +1,19 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/Debug/MayRecoilDebug.h"
+#include "HAL/IConsoleManager.h"
+
+#if MAYRECOIL_DEBUG
+
+static TAutoConsoleVariable<bool> CVarMayRecoilDebugOnScreen(
+	TEXT("MayRecoil.Debug.OnScreen"),
+	false,
+	TEXT("Prints the recoil state of all recoil workers as on-screen debug messages."),
+	ECVF_Cheat);
+
+bool MayRecoilDebug::IsOnScreenEnabled()
+{
+	return CVarMayRecoilDebugOnScreen.GetValueOnGameThread();
+}
+
+#endif
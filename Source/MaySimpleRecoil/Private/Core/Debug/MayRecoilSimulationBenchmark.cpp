@@ -0,0 +1,264 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/Debug/MayRecoilDebug.h"
+
+#if MAYRECOIL_DEBUG
+
+#include "Components/MaySimpleRecoilComponent.h"
+#include "Core/Data/MayRecoilData.h"
+#include "Core/Impl/MayRecoilEvaluator.h"
+#include "Core/Impl/MayRecoilSimulation.h"
+#include "Core/Settings/MayRecoilSettings.h"
+#include "Core/Subsystem/MayRecoilSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTime.h"
+#include "Tests/MayRecoilTestHelpers.h"
+
+namespace MayRecoilBenchmark
+{
+	// ============================================================================
+	// Allocation Counter
+	// ============================================================================
+
+	/**
+	 * Counts the calls to the global allocator for its lifetime, read from the counters FMalloc keeps itself.
+	 * The counters include all threads, so allocations of other threads during the scope are counted as well.
+	 */
+	struct FScopedAllocationCounter
+	{
+		FScopedAllocationCounter() : Start(GetTotalCalls()) {}
+
+		int64 GetNumAllocations() const { return static_cast<int64>(GetTotalCalls() - Start); }
+
+		/** @return Whether the global allocator counts its calls, probed once with a single allocation. */
+		static bool IsAvailable()
+		{
+			static const bool bAvailable = []()
+			{
+				const uint64 Before = GetTotalCalls();
+				FMemory::Free(FMemory::Malloc(16));
+				return GetTotalCalls() != Before;
+			}();
+			return bAvailable;
+		}
+
+	private:
+		static uint64 GetTotalCalls()
+		{
+			return static_cast<uint64>(FMalloc::TotalMallocCalls) + static_cast<uint64>(FMalloc::TotalReallocCalls);
+		}
+
+		uint64 Start = 0;
+	};
+
+	// ============================================================================
+	// Helpers
+	// ============================================================================
+
+	static double ToNanoseconds(double Seconds, int64 Count)
+	{
+		return Count > 0 ? Seconds * 1.0e9 / Count : 0.0;
+	}
+
+	// ============================================================================
+	// Simulation Benchmark
+	// ============================================================================
+
+	/** Measures shots and frames of N plain recoil states, the cost of the subsystem without any component around it. */
+	static void BenchmarkStates(UMayRecoilData* Data, int32 NumCharacters, int32 NumShots, int32 NumFrames)
+	{
+		constexpr int32 Seed = 1234;
+		constexpr float DeltaTime = 1.0f / 60.0f;
+
+		TArray<FMayRecoilState> States;
+		States.SetNum(NumCharacters);
+
+		// Shots, with one frame in between so the add phase is restarted like in a spray
+		double ShotSeconds = 0.0;
+		double FrameSeconds = 0.0;
+		int64 ShotAllocations = 0;
+		double Sink = 0.0;
+
+		for (int32 Shot = 0; Shot < NumShots; ++Shot)
+		{
+			{
+				FScopedAllocationCounter Allocations;
+				const double Start = FPlatformTime::Seconds();
+				for (FMayRecoilState& State : States)
+				{
+					const FVector2D YawAndPitch = FMayRecoilEvaluator::EvaluateShot(*Data, 1.0f, State.Random.NextShot(Seed), State.PatternIndex);
+					State.Fire(Data, YawAndPitch.X, YawAndPitch.Y);
+				}
+				ShotSeconds += FPlatformTime::Seconds() - Start;
+				ShotAllocations += Allocations.GetNumAllocations();
+			}
+
+			for (FMayRecoilState& State : States)
+			{
+				Sink += State.Advance(DeltaTime).Y;
+			}
+		}
+
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			const double Start = FPlatformTime::Seconds();
+			for (FMayRecoilState& State : States)
+			{
+				if (State.IsActive())
+				{
+					Sink += State.Advance(DeltaTime).Y;
+				}
+			}
+			FrameSeconds += FPlatformTime::Seconds() - Start;
+		}
+
+		const int64 TotalShots = static_cast<int64>(NumShots) * NumCharacters;
+		UE_LOG(LogTemp, Display, TEXT("  States     %4d characters  shot: %8.1f ns  frame: %10.1f ns  allocations per shot: %.3f  [%f]"),
+			NumCharacters, ToNanoseconds(ShotSeconds, TotalShots), ToNanoseconds(FrameSeconds, NumFrames),
+			TotalShots > 0 ? static_cast<double>(ShotAllocations) / TotalShots : 0.0, Sink);
+	}
+
+	/** Measures shots and frames of N recoil components in the given worker mode. */
+	static void BenchmarkComponents(UWorld* World, UMayRecoilData* Data, EMayRecoilWorkerMode WorkerMode, int32 NumCharacters, int32 NumShots, int32 NumFrames)
+	{
+		constexpr float DeltaTime = 1.0f / 60.0f;
+
+		UMayRecoilSubsystem* RecoilSubsystem = World->GetSubsystem<UMayRecoilSubsystem>();
+		if (!RecoilSubsystem) return; // Subsystem must exist
+
+		// Workers spawned for the run are destroyed at its end, the pool keeps its size
+		const int32 NumFreeWorkers = RecoilSubsystem->GetNumFreeWorkers();
+
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParameters.ObjectFlags |= RF_Transient;
+
+		TArray<AActor*> Actors;
+		TArray<UMaySimpleRecoilComponent*> Components;
+		for (int32 Index = 0; Index < NumCharacters; ++Index)
+		{
+			AActor* Actor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParameters);
+			UMaySimpleRecoilComponent* Component = NewObject<UMaySimpleRecoilComponent>(Actor);
+			Component->WorkerMode = WorkerMode;
+			Component->RecoilData = Data;
+			Component->SetRecoilSeed(Index + 1);
+			Actor->AddInstanceComponent(Component);
+			Component->RegisterComponent();
+
+			Actors.Add(Actor);
+			Components.Add(Component);
+		}
+
+		// Workers tick themselves in Actor mode, the subsystem ticks all states otherwise
+		auto TickFrame = [&]()
+		{
+			if (WorkerMode == EMayRecoilWorkerMode::Actor)
+			{
+				for (UMaySimpleRecoilComponent* Component : Components)
+				{
+					if (Component->RecoilWorkerInstance && Component->RecoilWorkerInstance->IsActorTickEnabled())
+					{
+						Component->RecoilWorkerInstance->Tick(DeltaTime);
+					}
+				}
+			}
+			else if (RecoilSubsystem->IsTickable())
+			{
+				RecoilSubsystem->Tick(DeltaTime);
+			}
+		};
+
+		double ShotSeconds = 0.0;
+		double FrameSeconds = 0.0;
+		int64 ShotAllocations = 0;
+
+		for (int32 Shot = 0; Shot < NumShots; ++Shot)
+		{
+			{
+				FScopedAllocationCounter Allocations;
+				const double Start = FPlatformTime::Seconds();
+				for (UMaySimpleRecoilComponent* Component : Components)
+				{
+					Component->Recoil();
+				}
+				ShotSeconds += FPlatformTime::Seconds() - Start;
+				ShotAllocations += Allocations.GetNumAllocations();
+			}
+
+			TickFrame();
+		}
+
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			const double Start = FPlatformTime::Seconds();
+			TickFrame();
+			FrameSeconds += FPlatformTime::Seconds() - Start;
+		}
+
+		// Destroying the actors returns their workers to the pool
+		for (AActor* Actor : Actors)
+		{
+			Actor->Destroy();
+		}
+		RecoilSubsystem->TrimWorkers(NumFreeWorkers);
+
+		const int64 TotalShots = static_cast<int64>(NumShots) * NumCharacters;
+		UE_LOG(LogTemp, Display, TEXT("  %-10s %4d characters  shot: %8.1f ns  frame: %10.1f ns  allocations per shot: %.3f"),
+			*StaticEnum<EMayRecoilWorkerMode>()->GetNameStringByValue(static_cast<int64>(WorkerMode)), NumCharacters,
+			ToNanoseconds(ShotSeconds, TotalShots), ToNanoseconds(FrameSeconds, NumFrames),
+			TotalShots > 0 ? static_cast<double>(ShotAllocations) / TotalShots : 0.0);
+	}
+
+	/**
+	 * Measures the cost per shot and per frame, and the allocations per shot, of 1, 100 and 1000 recoiling characters.
+	 * Runs the plain states and, in a game world, the components in Actor and Subsystem mode.
+	 */
+	static void BenchmarkSimulation(const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 NumShots = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 30;
+		const int32 NumFrames = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 120;
+		const int32 CharacterCounts[] = { 1, 100, 1000 };
+
+		if (GetDefault<UMayRecoilSettings>()->UseFixedStep())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("MayRecoil simulation benchmark: fixed steps are enabled, the world time does not advance during the benchmark so the components do not advance"));
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("MayRecoil simulation benchmark, %d shots and %d frames per run"), NumShots, NumFrames);
+
+		if (!FScopedAllocationCounter::IsAvailable())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("MayRecoil simulation benchmark: %s does not count its calls, the allocations are reported as 0"), GMalloc->GetDescriptiveName());
+		}
+
+		UMayRecoilData* Data = MayRecoilTest::MakeRecoilData(false, false);
+		for (const int32 NumCharacters : CharacterCounts)
+		{
+			BenchmarkStates(Data, NumCharacters, NumShots, NumFrames);
+		}
+
+		if (!World || !World->IsGameWorld() || !World->HasBegunPlay())
+		{
+			UE_LOG(LogTemp, Display, TEXT("  Components skipped, run the benchmark in a game or PIE world"));
+			return;
+		}
+
+		for (const EMayRecoilWorkerMode WorkerMode : { EMayRecoilWorkerMode::Actor, EMayRecoilWorkerMode::Subsystem })
+		{
+			for (const int32 NumCharacters : CharacterCounts)
+			{
+				BenchmarkComponents(World, Data, WorkerMode, NumCharacters, NumShots, NumFrames);
+			}
+		}
+	}
+
+	static FAutoConsoleCommand BenchmarkSimulationCommand(
+		TEXT("MayRecoil.Benchmark.Simulation"),
+		TEXT("Measures cost per shot, cost per frame and allocations per shot of 1, 100 and 1000 recoiling characters. Usage: MayRecoil.Benchmark.Simulation [NumShots] [NumFrames]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BenchmarkSimulation));
+}
+
+#endif
@@ -0,0 +1,359 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/Impl/MayRecoilEvaluator.h"
+#include "Core/Data/MayRecoilData.h"
+
+/**
+ * @brief Remaps a linear alpha with the given easing function.
+ *
+ * Uses the same FMath interpolation functions as UKismetMathLibrary::Ease, evaluated between 0 and 1.
+ */
+float FMayRecoilEvaluator::EaseAlpha(float Alpha, EEasingFunc::Type EasingFunc, float BlendExp, int32 Steps)
+{
+	switch (EasingFunc)
+	{
+	case EEasingFunc::Step:				return FMath::InterpStep(0.0f, 1.0f, Alpha, Steps);
+	case EEasingFunc::SinusoidalIn:		return FMath::InterpSinIn(0.0f, 1.0f, Alpha);
+	case EEasingFunc::SinusoidalOut:	return FMath::InterpSinOut(0.0f, 1.0f, Alpha);
+	case EEasingFunc::SinusoidalInOut:	return FMath::InterpSinInOut(0.0f, 1.0f, Alpha);
+	case EEasingFunc::EaseIn:			return FMath::InterpEaseIn(0.0f, 1.0f, Alpha, BlendExp);
+	case EEasingFunc::EaseOut:			return FMath::InterpEaseOut(0.0f, 1.0f, Alpha, BlendExp);
+	case EEasingFunc::EaseInOut:		return FMath::InterpEaseInOut(0.0f, 1.0f, Alpha, BlendExp);
+	case EEasingFunc::ExpoIn:			return FMath::InterpExpoIn(0.0f, 1.0f, Alpha);
+	case EEasingFunc::ExpoOut:			return FMath::InterpExpoOut(0.0f, 1.0f, Alpha);
+	case EEasingFunc::ExpoInOut:		return FMath::InterpExpoInOut(0.0f, 1.0f, Alpha);
+	case EEasingFunc::CircularIn:		return FMath::InterpCircularIn(0.0f, 1.0f, Alpha);
+	case EEasingFunc::CircularOut:		return FMath::InterpCircularOut(0.0f, 1.0f, Alpha);
+	case EEasingFunc::CircularInOut:	return FMath::InterpCircularInOut(0.0f, 1.0f, Alpha);
+	default:							return Alpha; // Linear
+	}
+}
+
+namespace MayRecoilEasingVector
+{
+	/** Evaluates the in and out half of an InOut function and selects by alpha, like FMath::Interp*InOut. */
+	template <typename InFunctionType, typename OutFunctionType>
+	FORCEINLINE VectorRegister4Float InOut(const VectorRegister4Float& Alpha, InFunctionType&& In, OutFunctionType&& Out)
+	{
+		const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+		const VectorRegister4Float Twice = VectorAdd(Alpha, Alpha);
+		const VectorRegister4Float InResult = VectorMultiply(In(Twice), Half);
+		const VectorRegister4Float OutResult = VectorMultiplyAdd(Out(VectorSubtract(Twice, VectorOne())), Half, Half);
+		return VectorSelect(VectorCompareLT(Alpha, Half), InResult, OutResult);
+	}
+
+	/** Runs a kernel over all full registers of Alphas, the rest with the scalar EaseAlpha. */
+	template <typename KernelType>
+	FORCEINLINE void Run(TConstArrayView<float> Alphas, TArrayView<float> OutEased, EEasingFunc::Type EasingFunc, float BlendExp, int32 Steps, KernelType&& Kernel)
+	{
+		const int32 Num = Alphas.Num();
+		int32 Index = 0;
+#if PLATFORM_ENABLE_VECTORINTRINSICS || PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+		for (; Index + 4 <= Num; Index += 4)
+		{
+			VectorStore(Kernel(VectorLoad(Alphas.GetData() + Index)), OutEased.GetData() + Index);
+		}
+#endif
+		for (; Index < Num; ++Index)
+		{
+			OutEased[Index] = FMayRecoilEvaluator::EaseAlpha(Alphas[Index], EasingFunc, BlendExp, Steps);
+		}
+	}
+}
+
+/**
+ * @brief Remaps many linear alphas with the same easing function, four at a time.
+ *
+ * The InOut functions evaluate both halves for all lanes and select per lane instead of branching.
+ */
+void FMayRecoilEvaluator::EaseAlphaBatch(TConstArrayView<float> Alphas, TArrayView<float> OutEased, EEasingFunc::Type EasingFunc, float BlendExp, int32 Steps)
+{
+	using namespace MayRecoilEasingVector;
+
+	if (!ensure(OutEased.Num() >= Alphas.Num())) return; // OutEased must hold all alphas
+
+	const VectorRegister4Float One = VectorOne();
+	const VectorRegister4Float Zero = VectorZero();
+	const VectorRegister4Float HalfPi = VectorSetFloat1(UE_HALF_PI);
+	const VectorRegister4Float Exp = VectorSetFloat1(BlendExp);
+	const VectorRegister4Float Ten = VectorSetFloat1(10.0f);
+
+	auto SinIn = [&](const VectorRegister4Float& A) { return VectorSubtract(One, VectorCos(VectorMultiply(A, HalfPi))); };
+	auto SinOut = [&](const VectorRegister4Float& A) { return VectorSin(VectorMultiply(A, HalfPi)); };
+	auto EaseIn = [&](const VectorRegister4Float& A) { return VectorPow(A, Exp); };
+	auto EaseOut = [&](const VectorRegister4Float& A) { return VectorSubtract(One, VectorPow(VectorSubtract(One, A), Exp)); };
+	auto ExpoIn = [&](const VectorRegister4Float& A)
+	{
+		return VectorSelect(VectorCompareEQ(A, Zero), Zero, VectorExp2(VectorMultiply(Ten, VectorSubtract(A, One))));
+	};
+	auto ExpoOut = [&](const VectorRegister4Float& A)
+	{
+		return VectorSelect(VectorCompareEQ(A, One), One, VectorSubtract(One, VectorExp2(VectorNegate(VectorMultiply(Ten, A)))));
+	};
+	auto CircularIn = [&](const VectorRegister4Float& A) { return VectorSubtract(One, VectorSqrt(VectorNegateMultiplyAdd(A, A, One))); };
+	auto CircularOut = [&](const VectorRegister4Float& A)
+	{
+		const VectorRegister4Float Shifted = VectorSubtract(A, One);
+		return VectorSqrt(VectorNegateMultiplyAdd(Shifted, Shifted, One));
+	};
+
+	switch (EasingFunc)
+	{
+	case EEasingFunc::Step:
+		{
+			if (Steps <= 1)
+			{
+				// FMath::InterpStep stays at the start for a single step
+				for (int32 Index = 0; Index < Alphas.Num(); ++Index)
+				{
+					OutEased[Index] = 0.0f;
+				}
+				return;
+			}
+
+			const VectorRegister4Float StepsVector = VectorSetFloat1(static_cast<float>(Steps));
+			const VectorRegister4Float Intervals = VectorSetFloat1(static_cast<float>(Steps - 1));
+			Run(Alphas, OutEased, EasingFunc, BlendExp, Steps, [&](const VectorRegister4Float& A)
+			{
+				const VectorRegister4Float Stepped = VectorDivide(VectorFloor(VectorMultiply(A, StepsVector)), Intervals);
+				return VectorSelect(VectorCompareLE(A, Zero), Zero, VectorSelect(VectorCompareGE(A, One), One, Stepped));
+			});
+			return;
+		}
+	case EEasingFunc::SinusoidalIn:		Run(Alphas, OutEased, EasingFunc, BlendExp, Steps, SinIn); return;
+	case EEasingFunc::SinusoidalOut:	Run(Alphas, OutEased, EasingFunc, BlendExp, Steps, SinOut); return;
+	case EEasingFunc::SinusoidalInOut:	Run(Alphas, OutEased, EasingFunc, BlendExp, Steps, [&](const VectorRegister4Float& A) { return InOut(A, SinIn, SinOut); }); return;
+	case EEasingFunc::EaseIn:			Run(Alphas, OutEased, EasingFunc, BlendExp, Steps, EaseIn); return;
+	case EEasingFunc::EaseOut:			Run(Alphas, OutEased, EasingFunc, BlendExp, Steps, EaseOut); return;
+	case EEasingFunc::EaseInOut:		Run(Alphas, OutEased, EasingFunc, BlendExp, Steps, [&](const VectorRegister4Float& A) { return InOut(A, EaseIn, EaseOut); }); return;
+	case EEasingFunc::ExpoIn:			Run(Alphas, OutEased, EasingFunc, BlendExp, Steps, ExpoIn); return;
+	case EEasingFunc::ExpoOut:			Run(Alphas, OutEased, EasingFunc, BlendExp, Steps, ExpoOut); return;
+	case EEasingFunc::ExpoInOut:		Run(Alphas, OutEased, EasingFunc, BlendExp, Steps, [&](const VectorRegister4Float& A) { return InOut(A, ExpoIn, ExpoOut); }); return;
+	case EEasingFunc::CircularIn:		Run(Alphas, OutEased, EasingFunc, BlendExp, Steps, CircularIn); return;
+	case EEasingFunc::CircularOut:		Run(Alphas, OutEased, EasingFunc, BlendExp, Steps, CircularOut); return;
+	case EEasingFunc::CircularInOut:	Run(Alphas, OutEased, EasingFunc, BlendExp, Steps, [&](const VectorRegister4Float& A) { return InOut(A, CircularIn, CircularOut); }); return;
+	default:
+		// Linear
+		for (int32 Index = 0; Index < Alphas.Num(); ++Index)
+		{
+			OutEased[Index] = Alphas[Index];
+		}
+		return;
+	}
+}
+
+/**
+ * @brief Returns the easing of the add phase of a recoil data asset.
+ */
+FMayRecoilEasing FMayRecoilEvaluator::GetAddEasing(const UMayRecoilData& Data)
+{
+	return { &Data.AddEasingTable, Data.RecoilInterpolation, Data.RecoilInterpolationEaseExp, Data.RecoilInterpolationSteps };
+}
+
+/**
+ * @brief Returns the easing of the reset phase of a recoil data asset.
+ */
+FMayRecoilEasing FMayRecoilEvaluator::GetResetEasing(const UMayRecoilData& Data)
+{
+	return { &Data.ResetEasingTable, Data.RecoilResetInterpolation, Data.RecoilResetInterpolationEaseExp, Data.RecoilResetInterpolationSteps };
+}
+
+/**
+ * @brief Evaluates the applied recoil of a shot.
+ */
+FVector2D FMayRecoilEvaluator::EvaluateAdd(const UMayRecoilData& Data, const FVector2D& YawAndPitch, float Alpha)
+{
+	return YawAndPitch * GetAddEasing(Data).Ease(Alpha);
+}
+
+/**
+ * @brief Evaluates the reset recoil.
+ */
+FVector2D FMayRecoilEvaluator::EvaluateReset(const UMayRecoilData& Data, const FVector2D& YawAndPitch, float Alpha)
+{
+	return YawAndPitch * GetResetEasing(Data).Ease(Alpha);
+}
+
+/**
+ * @brief Generates the yaw and pitch strength of a single shot.
+ *
+ * Uses the static pattern entry plus its jitter if the data has one, the random strength otherwise.
+ * Pitch is negated so positive strengths move the view up.
+ */
+FVector2D FMayRecoilEvaluator::EvaluateShot(const UMayRecoilData& Data, float Scale, FRandomStream& Stream, int32 PatternShotIndex)
+{
+	const int32 PatternIndex = Data.GetPatternTableIndex(PatternShotIndex);
+	if (PatternIndex != INDEX_NONE)
+	{
+		// Static pattern: fixed point of this shot plus its jitter
+		const FVector2f& Point = Data.PatternTable.Points[PatternIndex];
+		const FVector4f& Jitter = Data.PatternTable.Jitter[PatternIndex];
+
+		const float Pitch = (Point.Y + Stream.FRandRange(Jitter.Z, Jitter.W)) * Scale * -1;
+		const float Yaw = (Point.X + Stream.FRandRange(Jitter.X, Jitter.Y)) * Scale;
+		return FVector2D(Yaw, Pitch);
+	}
+
+	// Calculate vertical (pitch) recoil strength
+	const float Pitch = (Data.ForceMinMaxVerticalStrength ?
+				(Stream.FRand() < 0.5f ? Data.MaxRecoilVerticalStrength : Data.MinRecoilVerticalStrength) :
+				Stream.FRandRange(Data.MinRecoilVerticalStrength, Data.MaxRecoilVerticalStrength)
+			   ) * Scale * -1;
+	// Calculate horizontal (yaw) recoil strength
+	const float Yaw = (Data.ForceMinMaxHorizontalStrength ?
+			  (Stream.FRand() < 0.5f ? Data.MaxRecoilHorizontalStrength : Data.MinRecoilHorizontalStrength) :
+			  Stream.FRandRange(Data.MinRecoilHorizontalStrength, Data.MaxRecoilHorizontalStrength)
+			 ) * Scale;
+	return FVector2D(Yaw, Pitch);
+}
+
+// ============================================================================
+// Easing Table
+// ============================================================================
+
+/**
+ * @brief Returns whether a table for the given easing settings stays within MaxBakeError.
+ *
+ * Linear is the identity and Step has discontinuities that linear interpolation would smear.
+ */
+bool FMayRecoilEasingTable::CanBake(EEasingFunc::Type InEasingFunc, float InBlendExp)
+{
+	switch (InEasingFunc)
+	{
+	case EEasingFunc::Linear:
+	case EEasingFunc::Step:
+	case EEasingFunc::CircularIn:
+	case EEasingFunc::CircularOut:
+	case EEasingFunc::CircularInOut:
+		return false;
+	case EEasingFunc::EaseIn:
+	case EEasingFunc::EaseOut:
+	case EEasingFunc::EaseInOut:
+		return InBlendExp >= 1.0f && InBlendExp <= 6.0f;
+	default:
+		return true;
+	}
+}
+
+/**
+ * @brief Bakes the table for the given easing settings.
+ *
+ * Settings that CanBake rejects are left unbaked and evaluated directly.
+ */
+void FMayRecoilEasingTable::Bake(EEasingFunc::Type InEasingFunc, float InBlendExp, int32 InSteps)
+{
+	EasingFunc = InEasingFunc;
+	BlendExp = InBlendExp;
+	Steps = InSteps;
+	bBaked = CanBake(EasingFunc, BlendExp);
+
+	if (!bBaked) return;
+
+	for (int32 Index = 0; Index <= NumIntervals; ++Index)
+	{
+		Samples[Index] = FMayRecoilEvaluator::EaseAlpha(static_cast<float>(Index) / NumIntervals, EasingFunc, BlendExp, Steps);
+	}
+}
+
+// ============================================================================
+// Ease Batch
+// ============================================================================
+
+/**
+ * @brief Adds the alpha of an item to the group of its easing settings.
+ *
+ * States share a few recoil data assets, so a linear search over the groups is enough.
+ */
+void FMayRecoilEaseBatch::Add(int32 Item, float Alpha, const FMayRecoilEasing& Easing)
+{
+	FGroup* Group = nullptr;
+	for (int32 Index = 0; Index < NumGroups; ++Index)
+	{
+		FGroup& Candidate = Groups[Index];
+		if (Candidate.EasingFunc == Easing.EasingFunc && Candidate.BlendExp == Easing.BlendExp && Candidate.Steps == Easing.Steps)
+		{
+			Group = &Candidate;
+			break;
+		}
+	}
+
+	if (!Group)
+	{
+		// Reuse the group of an earlier frame with its memory
+		Group = NumGroups < Groups.Num() ? &Groups[NumGroups] : &Groups.AddDefaulted_GetRef();
+		Group->EasingFunc = Easing.EasingFunc;
+		Group->BlendExp = Easing.BlendExp;
+		Group->Steps = Easing.Steps;
+		++NumGroups;
+	}
+
+	Group->Items.Add(Item);
+	Group->Alphas.Add(Alpha);
+}
+
+/**
+ * @brief Eases the alphas of all groups.
+ */
+void FMayRecoilEaseBatch::Ease()
+{
+	for (FGroup& Group : GetGroups())
+	{
+		Group.Eased.SetNumUninitialized(Group.Alphas.Num());
+		FMayRecoilEvaluator::EaseAlphaBatch(Group.Alphas, Group.Eased, Group.EasingFunc, Group.BlendExp, Group.Steps);
+	}
+}
+
+/**
+ * @brief Removes all items, the groups keep their memory.
+ */
+void FMayRecoilEaseBatch::Reset()
+{
+	for (FGroup& Group : GetGroups())
+	{
+		Group.Items.Reset();
+		Group.Alphas.Reset();
+		Group.Eased.Reset();
+	}
+	NumGroups = 0;
+}
+
+// ============================================================================
+// Shot Accumulator
+// ============================================================================
+
+/**
+ * @brief Advances all in-flight shots.
+ *
+ * Each shot contributes the difference of its eased progress before and after this step,
+ * finished shots are removed.
+ */
+FVector2D FMayRecoilShotAccumulator::Advance(const UMayRecoilData& Data, float DeltaTime)
+{
+	if (bHasPending)
+	{
+		Shots.Add({ PendingYawAndPitch, 0.0f });
+		PendingYawAndPitch = FVector2D::ZeroVector;
+		bHasPending = false;
+	}
+
+	FVector2D Delta = FVector2D::ZeroVector;
+	const float Step = DeltaTime * Data.RecoilSpeed;
+
+	for (int32 Index = Shots.Num() - 1; Index >= 0; --Index)
+	{
+		FShot& Shot = Shots[Index];
+
+		const float PreviousEase = FMayRecoilEvaluator::EaseAlpha(Data.AddEasingTable, Shot.Alpha, Data.RecoilInterpolation, Data.RecoilInterpolationEaseExp, Data.RecoilInterpolationSteps);
+		Shot.Alpha = FMath::Min(Shot.Alpha + Step, 1.0f);
+		const float CurrentEase = FMayRecoilEvaluator::EaseAlpha(Data.AddEasingTable, Shot.Alpha, Data.RecoilInterpolation, Data.RecoilInterpolationEaseExp, Data.RecoilInterpolationSteps);
+
+		Delta += Shot.YawAndPitch * (CurrentEase - PreviousEase);
+
+		if (Shot.Alpha >= 1.0f)
+		{
+			Shots.RemoveAtSwap(Index);
+		}
+	}
+
+	return Delta;
+}
@@ -0,0 +1,106 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/Impl/MayRecoilSimulation.h"
+#include "Core/Data/MayRecoilData.h"
+#include "Core/Impl/MayRecoilEvaluator.h"
+
+// ============================================================================
+// Simulation
+// ============================================================================
+
+/**
+ * @brief Advances a recoil state by one step.
+ *
+ * Generates shots the same way UMayRecoilSubsystem::Recoil does, but without the component,
+ * so the result only depends on the arguments.
+ */
+FVector2D FMayRecoilSimulation::Step(FMayRecoilState& State, int32 Seed, const FMayRecoilFrameInput& Input, float DeltaTime)
+{
+	if (Input.PlayerYaw != 0.0f)
+	{
+		State.AddPlayerYaw(Input.PlayerYaw, DeltaTime);
+	}
+	if (Input.PlayerPitch != 0.0f)
+	{
+		State.AddPlayerPitch(Input.PlayerPitch);
+	}
+
+	if (Input.FireRecoilData)
+	{
+		const float Scale = Input.FireRecoilData->GetStateScale(Input.MovementState);
+		const FVector2D Shot = FMayRecoilEvaluator::EvaluateShot(*Input.FireRecoilData, Scale, State.Random.NextShot(Seed), State.PatternIndex);
+		State.Fire(Input.FireRecoilData, Shot.X, Shot.Y);
+	}
+
+	return State.IsActive() ? State.Advance(DeltaTime) : FVector2D::ZeroVector;
+}
+
+/**
+ * @brief Advances a recoil state by one frame the way UMayRecoilSubsystem does.
+ */
+FVector2D FMayRecoilSimulation::SimulateFrame(FMayRecoilState& State, int32 Seed, const FMayRecoilFrameInput& Input, double Time, float DeltaTime, float StepRate, int32 MaxSteps)
+{
+	if (StepRate <= 0.0f)
+	{
+		return Step(State, Seed, Input, DeltaTime);
+	}
+
+	if (Input.PlayerYaw != 0.0f)
+	{
+		State.AddPlayerYaw(Input.PlayerYaw, DeltaTime);
+	}
+	if (Input.PlayerPitch != 0.0f)
+	{
+		State.AddPlayerPitch(Input.PlayerPitch);
+	}
+
+	const FVector2D Delta = State.AdvanceFixed(Time, StepRate, MaxSteps);
+
+	if (Input.FireRecoilData)
+	{
+		const float Scale = Input.FireRecoilData->GetStateScale(Input.MovementState);
+		const FVector2D Shot = FMayRecoilEvaluator::EvaluateShot(*Input.FireRecoilData, Scale, State.Random.NextShot(Seed), State.PatternIndex);
+		State.Fire(Input.FireRecoilData, Shot.X, Shot.Y);
+	}
+
+	return Delta;
+}
+
+// ============================================================================
+// State History
+// ============================================================================
+
+FMayRecoilStateHistory::FMayRecoilStateHistory(int32 InCapacity)
+{
+	const int32 Capacity = FMath::Max(InCapacity, 1);
+	States.SetNum(Capacity);
+	Frames.Init(INDEX_NONE, Capacity);
+}
+
+void FMayRecoilStateHistory::SaveState(int32 Frame, const FMayRecoilState& State)
+{
+	if (Frame < 0) return; // Frame must be valid
+
+	const int32 Slot = Frame % States.Num();
+	States[Slot] = State;
+	Frames[Slot] = Frame;
+}
+
+bool FMayRecoilStateHistory::RestoreState(int32 Frame, FMayRecoilState& OutState) const
+{
+	if (Frame < 0) return false; // Frame must be valid
+
+	const int32 Slot = Frame % States.Num();
+	if (Frames[Slot] != Frame) return false; // Frame must still be in the buffer
+
+	OutState = States[Slot];
+	return true;
+}
+
+void FMayRecoilStateHistory::Reset()
+{
+	for (int32& Frame : Frames)
+	{
+		Frame = INDEX_NONE;
+	}
+}
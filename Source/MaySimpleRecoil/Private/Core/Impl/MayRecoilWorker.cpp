@@ -3,8 +3,9 @@
 #include "Core/Impl/MayRecoilWorker.h"
 #include "Components/MaySimpleRecoilComponent.h"
 #include "Core/Data/MayRecoilData.h"
-#include "Kismet/KismetSystemLibrary.h"
-#include "Kismet/KismetMathLibrary.h" // For ease functions
+#include "Core/Settings/MayRecoilSettings.h"
+#include "MayRecoilStats.h"
+#include "Core/Debug/MayRecoilDebug.h"
 
 // ============================================================================
 // Constructor and Initialization
@@ -14,12 +15,14 @@
  * @brief Constructor.
  *
  * Initializes the curve pointers to nullptr and enables ticking.
+ * The tick starts disabled and is only enabled while a timeline is playing.
  */
 AMayRecoilWorker::AMayRecoilWorker()
 	: AddRecoilCurve(nullptr)
 	, ResetRecoilCurve(nullptr)
 {
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 }
 
 /**
@@ -30,6 +33,8 @@ AMayRecoilWorker::AMayRecoilWorker()
  */
 void AMayRecoilWorker::initialize_recoil_timelines()
 {
+	if (EvaluationMode != EMayRecoilEvaluationMode::TimelineCurves) return; // Curves are only needed in compatibility mode
+
 	// --- Add-Recoil Timeline ---
 	if (AddRecoilCurve)
 	{
@@ -77,25 +82,286 @@ void AMayRecoilWorker::initialize_recoil_timelines()
 void AMayRecoilWorker::BeginPlay()
 {
 	Super::BeginPlay();
+	ResolveEvaluationMode();
 	initialize_recoil_timelines();
 }
 
+/**
+ * @brief Called after the worker has been loaded.
+ */
+void AMayRecoilWorker::PostLoad()
+{
+	Super::PostLoad();
+	ResolveEvaluationMode();
+}
+
+/**
+ * @brief Switches to TimelineCurves if curves are assigned but the worker is still in Analytic mode.
+ */
+void AMayRecoilWorker::ResolveEvaluationMode()
+{
+	if (EvaluationMode != EMayRecoilEvaluationMode::Analytic) return; // Already in compatibility mode
+	if (!AddRecoilCurve && !ResetRecoilCurve) return; // Curves are only used in compatibility mode
+
+	EvaluationMode = EMayRecoilEvaluationMode::TimelineCurves;
+	UE_LOG(LogTemp, Log, TEXT("%s has recoil curves assigned, using EvaluationMode TimelineCurves"), *GetNameSafe(this));
+}
+
+/**
+ * @brief Called when the actor is removed from play.
+ * @param EndPlayReason The reason why play ended.
+ */
+void AMayRecoilWorker::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	CancelResetDelay();
+	SetTickAwake(false);
+	Super::EndPlay(EndPlayReason);
+}
+
+/**
+ * @brief Enables or disables the actor tick and keeps the awake worker stat up to date.
+ * @param bAwake Whether the tick should be enabled.
+ */
+void AMayRecoilWorker::SetTickAwake(bool bAwake)
+{
+	if (bTickAwake == bAwake) return;
+
+	bTickAwake = bAwake;
+	SetActorTickEnabled(bAwake);
+
+	if (bAwake)
+	{
+		// The fixed steps start now, not when the worker went to sleep
+		const UMayRecoilSettings* Settings = GetDefault<UMayRecoilSettings>();
+		if (Settings->UseFixedStep())
+		{
+			FixedStep.Sync(GetWorld()->GetTimeSeconds(), Settings->FixedStepRate);
+		}
+
+		INC_DWORD_STAT(STAT_MayRecoilAwakeWorkers);
+	}
+	else
+	{
+		DEC_DWORD_STAT(STAT_MayRecoilAwakeWorkers);
+	}
+}
+
 /**
  * @brief Called every frame.
  * @param DeltaTime Time elapsed since the last frame.
  */
 void AMayRecoilWorker::Tick(float DeltaTime)
 {
+	MAYRECOIL_SCOPE_CYCLE_COUNTER(STAT_MayRecoilWorkerTick);
+
 	Super::Tick(DeltaTime);
 
-	// Update timelines
-	AddRecoilTimeline.TickTimeline(DeltaTime);
-	ResetRecoilTimeline.TickTimeline(DeltaTime);
+	if (GetDefault<UMayRecoilSettings>()->UseFixedStep())
+	{
+		AdvanceFixedSteps();
+	}
+	else
+	{
+		AdvanceRecoil(DeltaTime);
+	}
+
+	// Apply everything the phases added this frame in a single rotation update
+	FlushYawAndPitch();
 	
-	// Debug messages displaying current recoil state
-	GEngine->AddOnScreenDebugMessage(200, 5.0f, FColor::Blue, FString::Printf(TEXT("TempAddedPitch: %f %f"), AddedPitchAndYaw.X, AddedPitchAndYaw.Y));
-	GEngine->AddOnScreenDebugMessage(201, 5.0f, FColor::Blue, FString::Printf(TEXT("TempAddedYaw: %f"), TempAddedYaw));
-	GEngine->AddOnScreenDebugMessage(202, 5.0f, FColor::Blue, FString::Printf(TEXT("TempAddedPitch: %f"), TempAddedPitch));
+	// Debug messages displaying current recoil state (MayRecoil.Debug.OnScreen, see also the MayRecoil Gameplay Debugger category)
+	MAYRECOIL_DEBUG_MESSAGE(200, FColor::Blue, TEXT("AddedPitchAndYaw: %f %f"), AddedPitchAndYaw.X, AddedPitchAndYaw.Y);
+	MAYRECOIL_DEBUG_MESSAGE(201, FColor::Blue, TEXT("TempAddedYaw: %f"), TempAddedYaw);
+	MAYRECOIL_DEBUG_MESSAGE(202, FColor::Blue, TEXT("TempAddedPitch: %f"), TempAddedPitch);
+}
+
+/**
+ * @brief Advances the worker in fixed steps up to the current world time.
+ *
+ * While the worker sleeps only the clock moves, so waking up does not catch up on the idle time.
+ */
+void AMayRecoilWorker::AdvanceFixedSteps()
+{
+	const UMayRecoilSettings* Settings = GetDefault<UMayRecoilSettings>();
+	if (!Settings->UseFixedStep()) return;
+
+	const int32 NumSteps = FixedStep.Consume(GetWorld()->GetTimeSeconds(), Settings->FixedStepRate, Settings->MaxFixedStepsPerFrame);
+	const float StepTime = 1.0f / Settings->FixedStepRate;
+
+	for (int32 Step = 0; Step < NumSteps && bTickAwake; ++Step)
+	{
+		AdvanceRecoil(StepTime);
+	}
+}
+
+/**
+ * @brief Advances the reset delay and the add and reset phases.
+ * @param DeltaTime The time to advance.
+ */
+void AMayRecoilWorker::AdvanceRecoil(float DeltaTime)
+{
+	// Reset delay, counted down from the step after it was started
+	bool bResetDelayExpired = false;
+	if (bResetDelayActive)
+	{
+		ResetDelayRemaining -= DeltaTime;
+		bResetDelayExpired = ResetDelayRemaining <= 0.0f;
+	}
+
+	AdvancePhases(DeltaTime);
+
+	// Started after the phases, so the reset advances from the next step on like in FMayRecoilState::Advance
+	if (bResetDelayExpired)
+	{
+		CancelResetDelay();
+		AfterAddRecoilTimelineDelay();
+	}
+}
+
+/**
+ * @brief Advances the add and reset phases.
+ * @param DeltaTime The time to advance.
+ */
+void AMayRecoilWorker::AdvancePhases(float DeltaTime)
+{
+	MAYRECOIL_SCOPE_CYCLE_COUNTER(STAT_MayRecoilAdvancePhases);
+
+	if (EvaluationMode == EMayRecoilEvaluationMode::TimelineCurves)
+	{
+		// Update timelines
+		AddRecoilTimeline.TickTimeline(DeltaTime);
+		ResetRecoilTimeline.TickTimeline(DeltaTime);
+	}
+	else
+	{
+		// Accumulated shots: one superimposed delta for all shots in flight
+		if (ShotAccumulator.IsActive() && CurrentRecoilData)
+		{
+			const FVector2D Delta = ShotAccumulator.Advance(*CurrentRecoilData, DeltaTime);
+			QueueYawAndPitch(Delta.X, Delta.Y);
+			AddedPitchAndYaw += Delta;
+
+			if (!ShotAccumulator.IsActive())
+			{
+				OnAddRecoilTimelineFinished();
+			}
+		}
+
+		// Advance the native playbacks and call the callbacks directly, without delegate dispatch
+		if (AddRecoilPlayback.bPlaying)
+		{
+			const bool bFinished = AddRecoilPlayback.Advance(DeltaTime);
+			AddRecoilTimelineFloatReturn(AddRecoilPlayback.Position);
+			if (bFinished)
+			{
+				OnAddRecoilTimelineFinished();
+			}
+		}
+
+		if (ResetRecoilPlayback.bPlaying)
+		{
+			const bool bFinished = ResetRecoilPlayback.Advance(DeltaTime);
+			ResetRecoilTimelineFloatReturn(ResetRecoilPlayback.Position);
+			if (bFinished)
+			{
+				OnResetRecoilTimelineFinished();
+			}
+		}
+	}
+}
+
+// ============================================================================
+// Rotation Apply
+// ============================================================================
+
+/**
+ * @brief Adds yaw and pitch to the rotation applied at the end of the tick.
+ */
+void AMayRecoilWorker::QueueYawAndPitch(float Yaw, float Pitch)
+{
+	PendingYawAndPitch += FVector2D(Yaw, Pitch);
+}
+
+/**
+ * @brief Applies the queued yaw and pitch to the player in a single call.
+ */
+void AMayRecoilWorker::FlushYawAndPitch()
+{
+	if (PendingYawAndPitch.IsZero()) return;
+
+	const FVector2D YawAndPitch = PendingYawAndPitch;
+	PendingYawAndPitch = FVector2D::ZeroVector;
+
+	if (CurrentComponent)
+	{
+		CurrentComponent->ApplyRecoilYawAndPitch(YawAndPitch.X, YawAndPitch.Y);
+	}
+}
+
+// ============================================================================
+// Phase Playback
+// ============================================================================
+
+void AMayRecoilWorker::PlayAddRecoil(float PlayRate, float Position)
+{
+	if (EvaluationMode == EMayRecoilEvaluationMode::TimelineCurves)
+	{
+		AddRecoilTimeline.SetPlayRate(PlayRate);
+		AddRecoilTimeline.SetPlaybackPosition(Position, false);
+		AddRecoilTimeline.Play();
+	}
+	else
+	{
+		AddRecoilPlayback.PlayFromStart(PlayRate);
+		AddRecoilPlayback.Position = Position;
+	}
+}
+
+void AMayRecoilWorker::PlayResetRecoil(float PlayRate, float Position)
+{
+	if (EvaluationMode == EMayRecoilEvaluationMode::TimelineCurves)
+	{
+		ResetRecoilTimeline.SetPlayRate(PlayRate);
+		ResetRecoilTimeline.SetPlaybackPosition(Position, false);
+		ResetRecoilTimeline.Play();
+	}
+	else
+	{
+		ResetRecoilPlayback.PlayFromStart(PlayRate);
+		ResetRecoilPlayback.Position = Position;
+	}
+}
+
+void AMayRecoilWorker::StopAddRecoil()
+{
+	AddRecoilTimeline.Stop();
+	AddRecoilPlayback.Stop();
+	ShotAccumulator.Reset();
+}
+
+void AMayRecoilWorker::StopResetRecoil()
+{
+	ResetRecoilTimeline.Stop();
+	ResetRecoilPlayback.Stop();
+}
+
+bool AMayRecoilWorker::IsAddRecoilPlaying() const
+{
+	return EvaluationMode == EMayRecoilEvaluationMode::TimelineCurves ? AddRecoilTimeline.IsPlaying() : AddRecoilPlayback.bPlaying || ShotAccumulator.IsActive();
+}
+
+bool AMayRecoilWorker::IsResetRecoilPlaying() const
+{
+	return EvaluationMode == EMayRecoilEvaluationMode::TimelineCurves ? ResetRecoilTimeline.IsPlaying() : ResetRecoilPlayback.bPlaying;
+}
+
+float AMayRecoilWorker::GetAddRecoilPosition() const
+{
+	return EvaluationMode == EMayRecoilEvaluationMode::TimelineCurves ? AddRecoilTimeline.GetPlaybackPosition() : AddRecoilPlayback.Position;
+}
+
+float AMayRecoilWorker::GetResetRecoilPosition() const
+{
+	return EvaluationMode == EMayRecoilEvaluationMode::TimelineCurves ? ResetRecoilTimeline.GetPlaybackPosition() : ResetRecoilPlayback.Position;
 }
 
 // ============================================================================
@@ -132,14 +398,36 @@ void AMayRecoilWorker::SetCurrentRecoilData(UMayRecoilData* RecoilData)
  */
 void AMayRecoilWorker::Recoil_Implementation()
 {
+	MAYRECOIL_SCOPE_CYCLE_COUNTER(STAT_MayRecoilRecoil);
+
 	if (!CurrentRecoilData) return; // RecoilData must be valid
+	INC_DWORD_STAT(STAT_MayRecoilShots);
+
+	// With fixed steps the shot starts at the current step, not at the last tick
+	AdvanceFixedSteps();
 	
 	// Calculate recoil strengths
 	GetRecoilYawAndPitchStrength_Implementation(CurrentOutYaw, CurrentOutPitch);
 
-	// Stop both timelines if they are playing
-	AddRecoilTimeline.Stop();
-	ResetRecoilTimeline.Stop();
+	if (CurrentRecoilData->AccumulateShots && EvaluationMode == EMayRecoilEvaluationMode::Analytic)
+	{
+		// Superimpose the shot on the ones in flight instead of restarting the add phase
+		AddRecoilPlayback.Stop();
+		StopResetRecoil();
+		CancelResetDelay();
+		TempRecoilResetPitchOffset = 0.0f;
+
+		ShotAccumulator.Queue(FVector2D(CurrentOutYaw, CurrentOutPitch));
+		SetTickAwake(true);
+		return;
+	}
+
+	// A new shot continues the spray, the pending reset is dropped
+	CancelResetDelay();
+
+	// Stop both phases if they are playing
+	StopAddRecoil();
+	StopResetRecoil();
 
 	// Reset temporary values
 	TempRecoilResetPitchOffset = 0.0f;
@@ -147,8 +435,9 @@ void AMayRecoilWorker::Recoil_Implementation()
 	TempAddedYaw = 0.0f;
 	
 	// Set the play rate based on recoil data and play from the start
-	AddRecoilTimeline.SetPlayRate(CurrentRecoilData->RecoilSpeed);
-	AddRecoilTimeline.PlayFromStart();
+	PlayAddRecoil(CurrentRecoilData->RecoilSpeed);
+
+	SetTickAwake(true);
 }
 
 /**
@@ -157,14 +446,15 @@ void AMayRecoilWorker::Recoil_Implementation()
  */
 void AMayRecoilWorker::AddRecoilTimelineFloatReturn(float Value)
 {
-	GEngine->AddOnScreenDebugMessage(203, 5.0f, FColor::Magenta, FString::Printf(TEXT("Value: %f"), Value));
+	MAYRECOIL_DEBUG_MESSAGE(203, FColor::Magenta, TEXT("Value: %f"), Value);
 
 	// Calculate eased yaw and pitch values using the ease function
-	float EaseYaw = UKismetMathLibrary::Ease(0.0f, CurrentOutYaw, Value, CurrentRecoilData->RecoilInterpolation, CurrentRecoilData->RecoilInterpolationEaseExp, CurrentRecoilData->RecoilInterpolationSteps);
-	float EasePitch = UKismetMathLibrary::Ease(0.0f, CurrentOutPitch, Value, CurrentRecoilData->RecoilInterpolation, CurrentRecoilData->RecoilInterpolationEaseExp, CurrentRecoilData->RecoilInterpolationSteps);
+	const FVector2D Eased = FMayRecoilEvaluator::EvaluateAdd(*CurrentRecoilData, FVector2D(CurrentOutYaw, CurrentOutPitch), Value);
+	const float EaseYaw = Eased.X;
+	const float EasePitch = Eased.Y;
 	
-	// Update the player's yaw and pitch using the calculated differences
-	CurrentComponent->UpdatePlayerYawAndPitch(
+	// Update the player's yaw and pitch using the calculated differences (applied once at the end of the tick)
+	QueueYawAndPitch(
 		EaseYaw - TempAddedYaw,
 		EasePitch - TempAddedPitch
 	);
@@ -179,17 +469,34 @@ void AMayRecoilWorker::AddRecoilTimelineFloatReturn(float Value)
 /**
  * @brief Called when the AddRecoil timeline finishes playing.
  *
- * Triggers a delayed callback that will initiate the recoil reset process.
+ * Triggers a delayed callback that ends the spray and initiates the recoil reset process.
+ * The delay also runs if the recoil is never reset, the static pattern still restarts at its end.
  */
 void AMayRecoilWorker::OnAddRecoilTimelineFinished()
 {
-	FLatentActionInfo LatentInfo;
-	LatentInfo.CallbackTarget = this;
-	LatentInfo.ExecutionFunction = FName("AfterAddRecoilTimelineDelay");
-	LatentInfo.Linkage = 0;
-	LatentInfo.UUID = 0;
-	
-	UKismetSystemLibrary::RetriggerableDelay(this, CurrentRecoilData->RecoilResetDelay, LatentInfo);
+	StartResetDelay(CurrentRecoilData->RecoilResetDelay);
+}
+
+/**
+ * @brief Starts the delay after which the reset phase begins.
+ * @param Duration The delay in seconds.
+ */
+void AMayRecoilWorker::StartResetDelay(float Duration)
+{
+	ResetDelayRemaining = Duration;
+	bResetDelayActive = true;
+
+	// The countdown runs in Tick
+	SetTickAwake(true);
+}
+
+/**
+ * @brief Cancels a running reset delay.
+ */
+void AMayRecoilWorker::CancelResetDelay()
+{
+	ResetDelayRemaining = 0.0f;
+	bResetDelayActive = false;
 }
 
 /**
@@ -199,6 +506,19 @@ void AMayRecoilWorker::OnAddRecoilTimelineFinished()
  */
 void AMayRecoilWorker::AfterAddRecoilTimelineDelay()
 {
+	// The spray is over, the next shot starts the static pattern from the beginning
+	PatternIndex = 0;
+
+	// Nothing left to tick if the recoil is never reset
+	if (!CurrentRecoilData || !CurrentRecoilData->RecoilResetRecoil)
+	{
+		if (!IsAddRecoilPlaying())
+		{
+			SetTickAwake(false);
+		}
+		return;
+	}
+
 	ResetRecoil_Implementation();
 }
 
@@ -210,11 +530,7 @@ float AMayRecoilWorker::GetRecoilScale_Implementation()
 {
 	if (!CurrentComponent) return 1.0f; // Component must be valid
 	if (!CurrentRecoilData) return 1.0f;  // RecoilData must be valid
-	return CurrentRecoilData->RecoilScale *
-		(CurrentComponent->IsCrouching_Implementation() ? CurrentRecoilData->RecoilScaleCrouch : 1) *
-		(CurrentComponent->IsSprinting_Implementation() ? CurrentRecoilData->RecoilScaleSprint : 1) *
-		(CurrentComponent->IsJumping_Implementation() ? CurrentRecoilData->RecoilScaleJump : 1) *
-		(CurrentComponent->IsADS_Implementation() ? CurrentRecoilData->RecoilScaleADS : 1);
+	return CurrentComponent->CalculateRecoilScale(CurrentRecoilData);
 }
 
 /**
@@ -227,18 +543,20 @@ void AMayRecoilWorker::GetRecoilYawAndPitchStrength_Implementation(float& OutYaw
 	if (!CurrentComponent) return; // Component must be valid
 	if (!CurrentRecoilData) return;  // RecoilData must be valid
 
-	float Scale = GetRecoilScale_Implementation();
-	
-	// Calculate vertical (pitch) recoil strength
-	OutPitch = (CurrentRecoilData->ForceMinMaxVerticalStrength ? 
-				(FMath::RandBool() ? CurrentRecoilData->MaxRecoilVerticalStrength : CurrentRecoilData->MinRecoilVerticalStrength) : 
-				FMath::FRandRange(CurrentRecoilData->MinRecoilVerticalStrength, CurrentRecoilData->MaxRecoilVerticalStrength)
-			   ) * Scale * -1;
-	// Calculate horizontal (yaw) recoil strength
-	OutYaw = (CurrentRecoilData->ForceMinMaxHorizontalStrength ? 
-			  (FMath::RandBool() ? CurrentRecoilData->MaxRecoilHorizontalStrength : CurrentRecoilData->MinRecoilHorizontalStrength) : 
-			  FMath::FRandRange(CurrentRecoilData->MinRecoilHorizontalStrength, CurrentRecoilData->MaxRecoilHorizontalStrength)
-			 ) * Scale;
+	CurrentComponent->GenerateShot(CurrentRecoilData, GetRecoilScale_Implementation(), RecoilRandom, PatternIndex, OutYaw, OutPitch);
+	++PatternIndex;
+}
+
+/**
+ * @brief Applies a server correction.
+ *
+ * The delta is added to the accumulated recoil, so the reset also takes it back.
+ * The rotation itself is applied by the component.
+ */
+void AMayRecoilWorker::ApplyCorrection(int32 NextShotIndex, int32 NextPatternIndex, const FVector2D& Delta)
+{
+	RecoilRandom.ApplyCorrection(NextShotIndex, NextPatternIndex, PatternIndex);
+	AddedPitchAndYaw += Delta;
 }
 
 /**
@@ -249,19 +567,22 @@ void AMayRecoilWorker::GetRecoilYawAndPitchStrength_Implementation(float& OutYaw
  */
 void AMayRecoilWorker::ResetRecoil_Implementation()
 {
+	MAYRECOIL_SCOPE_CYCLE_COUNTER(STAT_MayRecoilReset);
+
 	if (!CurrentRecoilData->RecoilResetRecoil) return; // Recoil reset must be enabled
-	if (AddRecoilTimeline.IsPlaying()) return; // AddRecoilTimeline must not be playing
+	if (IsAddRecoilPlaying()) return; // AddRecoil phase must not be playing
 
-	ResetRecoilTimeline.Stop();
+	StopResetRecoil();
 	
 	// Reset temporary values for the reset process
 	TempAddedYaw = 0.0f;
 	TempAddedPitch = 0.0f;
 	TempAddedPitchAndYaw = AddedPitchAndYaw;
 
-	// Set the play rate for the reset timeline and play from start
-	ResetRecoilTimeline.SetPlayRate(CurrentRecoilData->RecoilResetSpeed);
-	ResetRecoilTimeline.PlayFromStart();
+	// Set the play rate for the reset phase and play from start
+	PlayResetRecoil(CurrentRecoilData->RecoilResetSpeed);
+
+	SetTickAwake(true);
 }
 
 /**
@@ -270,16 +591,17 @@ void AMayRecoilWorker::ResetRecoil_Implementation()
  */
 void AMayRecoilWorker::ResetRecoilTimelineFloatReturn(float Value)
 {
-	GEngine->AddOnScreenDebugMessage(204, 5.0f, FColor::Magenta, FString::Printf(TEXT("Value: %f"), Value));
+	MAYRECOIL_DEBUG_MESSAGE(204, FColor::Magenta, TEXT("Value: %f"), Value);
 	if (!CurrentComponent) return; // Component must be valid
 	if (!CurrentRecoilData) return;  // RecoilData must be valid
 	
 	// Calculate eased values for yaw and pitch during the reset process
-	float EaseYaw = UKismetMathLibrary::Ease(0.0f, TempAddedPitchAndYaw.X, Value, CurrentRecoilData->RecoilResetInterpolation, CurrentRecoilData->RecoilResetInterpolationEaseExp, CurrentRecoilData->RecoilResetInterpolationSteps);
-	float EasePitch = UKismetMathLibrary::Ease(0.0f, TempAddedPitchAndYaw.Y, Value, CurrentRecoilData->RecoilResetInterpolation, CurrentRecoilData->RecoilResetInterpolationEaseExp, CurrentRecoilData->RecoilResetInterpolationSteps);
+	const FVector2D Eased = FMayRecoilEvaluator::EvaluateReset(*CurrentRecoilData, TempAddedPitchAndYaw, Value);
+	const float EaseYaw = Eased.X;
+	const float EasePitch = Eased.Y;
 	
-	// Update the player's yaw and pitch to reverse the recoil
-	CurrentComponent->UpdatePlayerYawAndPitch(
+	// Update the player's yaw and pitch to reverse the recoil (applied once at the end of the tick)
+	QueueYawAndPitch(
 		(EaseYaw - TempAddedYaw) * -1.0f,
 		(EasePitch - TempAddedPitch) * -1.0f
 	);
@@ -295,7 +617,11 @@ void AMayRecoilWorker::ResetRecoilTimelineFloatReturn(float Value)
  */
 void AMayRecoilWorker::OnResetRecoilTimelineFinished()
 {
-	// No additional logic is needed here.
+	// Both phases are done, put the worker to sleep until the next shot
+	if (!IsAddRecoilPlaying())
+	{
+		SetTickAwake(false);
+	}
 }
 
 /**
@@ -305,24 +631,118 @@ void AMayRecoilWorker::OnResetRecoilTimelineFinished()
  */
 void AMayRecoilWorker::ResetRecoilState_Implementation()
 {
-	ResetRecoilTimeline.Stop();
-	AddRecoilTimeline.Stop();
+	StopResetRecoil();
+	StopAddRecoil();
 
 	AddedPitchAndYaw = FVector2D::ZeroVector;
 	TempAddedPitchAndYaw = FVector2D::ZeroVector;
+	PatternIndex = 0;
+
+	CancelResetDelay();
+	SetTickAwake(false);
+}
+
+// ============================================================================
+// Packed State
+// ============================================================================
+
+/**
+ * @brief Quantizes the current recoil state.
+ *
+ * Maps the worker members onto an FMayRecoilState and packs it.
+ */
+FMayRecoilPackedState AMayRecoilWorker::PackState() const
+{
+	FMayRecoilState State;
+	State.RecoilData = CurrentRecoilData;
+	State.ShotYawAndPitch = FVector2D(CurrentOutYaw, CurrentOutPitch);
+	State.AppliedYawAndPitch = FVector2D(TempAddedYaw, TempAddedPitch);
+	State.AddedPitchAndYaw = AddedPitchAndYaw;
+	State.ResetFromPitchAndYaw = TempAddedPitchAndYaw;
+	State.ResetPitchOffset = TempRecoilResetPitchOffset;
+	State.Random = RecoilRandom;
+	State.PatternIndex = PatternIndex;
+	State.ShotAccumulator = ShotAccumulator;
+
+	if (IsAddRecoilPlaying())
+	{
+		State.Phase = EMayRecoilPhase::Adding;
+		State.Alpha = GetAddRecoilPosition();
+	}
+	else if (IsResetRecoilPlaying())
+	{
+		State.Phase = EMayRecoilPhase::Resetting;
+		State.Alpha = GetResetRecoilPosition();
+	}
+	else if (bResetDelayActive)
+	{
+		State.Phase = EMayRecoilPhase::WaitingForReset;
+		State.ResetDelayRemaining = ResetDelayRemaining;
+	}
+
+	return State.Pack();
+}
+
+/**
+ * @brief Restores the recoil state and continues the phase it was packed in.
+ */
+void AMayRecoilWorker::UnpackState(const FMayRecoilPackedState& Packed)
+{
+	FMayRecoilState State;
+	State.Unpack(Packed, CurrentRecoilData);
+
+	StopAddRecoil();
+	StopResetRecoil();
+	CancelResetDelay();
+
+	CurrentOutYaw = State.ShotYawAndPitch.X;
+	CurrentOutPitch = State.ShotYawAndPitch.Y;
+	TempAddedYaw = State.AppliedYawAndPitch.X;
+	TempAddedPitch = State.AppliedYawAndPitch.Y;
+	AddedPitchAndYaw = State.AddedPitchAndYaw;
+	TempAddedPitchAndYaw = State.ResetFromPitchAndYaw;
+	TempRecoilResetPitchOffset = State.ResetPitchOffset;
+	RecoilRandom.ShotIndex = State.Random.ShotIndex;
+	PatternIndex = State.PatternIndex;
+
+	if (!CurrentRecoilData)
+	{
+		SetTickAwake(false);
+		return;
+	}
+
+	switch (State.Phase)
+	{
+	case EMayRecoilPhase::Adding:
+		PlayAddRecoil(CurrentRecoilData->RecoilSpeed, State.Alpha);
+		SetTickAwake(true);
+		break;
+	case EMayRecoilPhase::WaitingForReset:
+		StartResetDelay(State.ResetDelayRemaining);
+		SetTickAwake(true);
+		break;
+	case EMayRecoilPhase::Resetting:
+		PlayResetRecoil(CurrentRecoilData->RecoilResetSpeed, State.Alpha);
+		SetTickAwake(true);
+		break;
+	default:
+		SetTickAwake(false);
+		break;
+	}
 }
 
 /**
  * @brief Handles the addition of yaw.
  *
- * Interpolates the accumulated yaw value back to zero.
+ * Decays the accumulated yaw value back to zero, independent of the frame rate.
  * @param Yaw The yaw value to add.
  */
 void AMayRecoilWorker::OnYawAdded_Implementation(float Yaw)
 {
 	if (Yaw == 0.0f) return; // Validate input
 
-	AddedPitchAndYaw = FVector2D(FMath::FInterpTo(AddedPitchAndYaw.X, 0, GetWorld()->GetDeltaSeconds(), 10), AddedPitchAndYaw.Y);
+	const float Decay = FMath::Exp(-GetDefault<UMayRecoilSettings>()->PlayerYawRecoverySpeed * GetWorld()->GetDeltaSeconds());
+	AddedPitchAndYaw = FVector2D(AddedPitchAndYaw.X * Decay, AddedPitchAndYaw.Y);
 }
 
 /**
@@ -341,11 +761,12 @@ void AMayRecoilWorker::OnPitchAdded_Implementation(float Pitch)
 
 	// If the reset timeline is playing and a negative pitch is applied,
 	// check if the recoil reset should be triggered again.
-	if (ResetRecoilTimeline.IsPlaying() && Pitch < 0.0f)
+	if (IsResetRecoilPlaying() && Pitch < 0.0f)
 	{
 		TempRecoilResetPitchOffset += FMath::Abs(Pitch);
 		if (TempRecoilResetPitchOffset >= FMath::Abs(TempAddedPitchAndYaw.Y) * 1.1)
 		{
+			INC_DWORD_STAT(STAT_MayRecoilResetRestarts);
 			ResetRecoil_Implementation();
 			TempRecoilResetPitchOffset = 0.0f;
 		}
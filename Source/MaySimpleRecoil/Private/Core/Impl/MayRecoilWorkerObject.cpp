@@ -0,0 +1,142 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/Impl/MayRecoilWorkerObject.h"
+#include "Components/MaySimpleRecoilComponent.h"
+#include "Core/Data/MayRecoilData.h"
+#include "Core/Subsystem/MayRecoilSubsystem.h"
+
+// ============================================================================
+// Component and Data Setup Functions
+// ============================================================================
+
+/**
+ * @brief Sets the current recoil component.
+ * @param NewComponent Pointer to the new recoil component.
+ */
+void UMayRecoilWorkerObject::SetCurrentComponent(UMaySimpleRecoilComponent* NewComponent)
+{
+	CurrentComponent = NewComponent;
+}
+
+/**
+ * @brief Sets the current recoil data.
+ * @param RecoilData Pointer to the new recoil data.
+ */
+void UMayRecoilWorkerObject::SetCurrentRecoilData(UMayRecoilData* RecoilData)
+{
+	CurrentRecoilData = RecoilData;
+}
+
+UMayRecoilSubsystem* UMayRecoilWorkerObject::GetRecoilSubsystem() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetSubsystem<UMayRecoilSubsystem>() : nullptr;
+}
+
+UWorld* UMayRecoilWorkerObject::GetWorld() const
+{
+	// The class default object has no world, which tells the editor that world context nodes are not available
+	if (HasAnyFlags(RF_ClassDefaultObject)) return nullptr;
+	return CurrentComponent ? CurrentComponent->GetWorld() : nullptr;
+}
+
+// ============================================================================
+// Recoil Functionality
+// ============================================================================
+
+/**
+ * @brief Fires a shot with the strength from GetRecoilYawAndPitchStrength.
+ *
+ * Calls the events instead of their implementations, so Blueprint overrides of the strength and scale are used.
+ */
+void UMayRecoilWorkerObject::Recoil_Implementation()
+{
+	if (!CurrentComponent) return; // Component must be valid
+	if (!CurrentRecoilData) return; // RecoilData must be valid
+
+	UMayRecoilSubsystem* RecoilSubsystem = GetRecoilSubsystem();
+	if (!RecoilSubsystem) return;
+
+	float Yaw = 0.0f;
+	float Pitch = 0.0f;
+	GetRecoilYawAndPitchStrength(Yaw, Pitch);
+
+	RecoilSubsystem->Fire(CurrentComponent, CurrentRecoilData, Yaw, Pitch);
+}
+
+/**
+ * @brief Starts resetting the accumulated recoil.
+ */
+void UMayRecoilWorkerObject::ResetRecoil_Implementation()
+{
+	if (UMayRecoilSubsystem* RecoilSubsystem = GetRecoilSubsystem())
+	{
+		RecoilSubsystem->BeginReset(CurrentComponent);
+	}
+}
+
+/**
+ * @brief Immediately resets the recoil state.
+ */
+void UMayRecoilWorkerObject::ResetRecoilState_Implementation()
+{
+	if (UMayRecoilSubsystem* RecoilSubsystem = GetRecoilSubsystem())
+	{
+		RecoilSubsystem->ResetRecoilState(CurrentComponent);
+	}
+}
+
+/**
+ * @brief Calculates the recoil scale factor based on the current component state and recoil data.
+ * @return The calculated recoil scale.
+ */
+float UMayRecoilWorkerObject::GetRecoilScale_Implementation()
+{
+	if (!CurrentComponent) return 1.0f; // Component must be valid
+	if (!CurrentRecoilData) return 1.0f;  // RecoilData must be valid
+	return CurrentComponent->CalculateRecoilScale(CurrentRecoilData);
+}
+
+/**
+ * @brief Calculates the yaw and pitch strengths for the recoil.
+ * @param OutYaw Output parameter for the calculated yaw strength.
+ * @param OutPitch Output parameter for the calculated pitch strength.
+ */
+void UMayRecoilWorkerObject::GetRecoilYawAndPitchStrength_Implementation(float& OutYaw, float& OutPitch)
+{
+	if (!CurrentComponent) return; // Component must be valid
+	if (!CurrentRecoilData) return;  // RecoilData must be valid
+
+	UMayRecoilSubsystem* RecoilSubsystem = GetRecoilSubsystem();
+	FMayRecoilState* State = RecoilSubsystem ? RecoilSubsystem->FindState(CurrentComponent) : nullptr;
+	if (!State) return; // Component must be registered
+
+	// The pattern index is advanced by FMayRecoilState::Fire
+	CurrentComponent->GenerateShot(CurrentRecoilData, GetRecoilScale(), State->Random, State->PatternIndex, OutYaw, OutPitch);
+}
+
+/**
+ * @brief Handles the addition of yaw.
+ * @param Yaw The yaw value to add.
+ */
+void UMayRecoilWorkerObject::OnYawAdded_Implementation(float Yaw)
+{
+	UMayRecoilSubsystem* RecoilSubsystem = GetRecoilSubsystem();
+	if (FMayRecoilState* State = RecoilSubsystem ? RecoilSubsystem->FindState(CurrentComponent) : nullptr)
+	{
+		State->AddPlayerYaw(Yaw, GetWorld()->GetDeltaSeconds());
+	}
+}
+
+/**
+ * @brief Handles the addition of pitch.
+ * @param Pitch The pitch value to add.
+ */
+void UMayRecoilWorkerObject::OnPitchAdded_Implementation(float Pitch)
+{
+	UMayRecoilSubsystem* RecoilSubsystem = GetRecoilSubsystem();
+	if (FMayRecoilState* State = RecoilSubsystem ? RecoilSubsystem->FindState(CurrentComponent) : nullptr)
+	{
+		State->AddPlayerPitch(Pitch);
+	}
+}
@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/Net/MayRecoilNetTypes.h"
+
+/**
+ * @brief Serializes the packed state.
+ *
+ * The phase takes two bits. Shot, progress and reset fields are only written if the phase uses them,
+ * the indices are written packed.
+ */
+bool FMayRecoilPackedState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	// Matches EMayRecoilPhase
+	constexpr uint8 PhaseIdle = 0;
+	constexpr uint8 PhaseAdding = 1;
+	constexpr uint8 PhaseWaitingForReset = 2;
+	constexpr uint8 PhaseResetting = 3;
+
+	Ar.SerializeBits(&Phase, 2);
+	Ar << AddedYaw;
+	Ar << AddedPitch;
+
+	uint32 PackedShotIndex = static_cast<uint32>(ShotIndex);
+	uint32 PackedPatternIndex = static_cast<uint32>(PatternIndex);
+	Ar.SerializeIntPacked(PackedShotIndex);
+	Ar.SerializeIntPacked(PackedPatternIndex);
+
+	if (Phase == PhaseAdding || Phase == PhaseResetting)
+	{
+		Ar << Alpha;
+	}
+	if (Phase == PhaseAdding)
+	{
+		Ar << ShotYaw;
+		Ar << ShotPitch;
+	}
+	if (Phase == PhaseWaitingForReset)
+	{
+		Ar << ResetDelayRemaining;
+	}
+	if (Phase == PhaseResetting)
+	{
+		Ar << ResetFromYaw;
+		Ar << ResetFromPitch;
+		Ar << ResetPitchOffset;
+	}
+
+	if (Ar.IsLoading())
+	{
+		ShotIndex = static_cast<int32>(PackedShotIndex);
+		PatternIndex = static_cast<int32>(PackedPatternIndex);
+
+		// Fields of other phases are not sent
+		if (Phase != PhaseAdding)
+		{
+			ShotYaw = ShotPitch = 0;
+		}
+		if (Phase != PhaseWaitingForReset)
+		{
+			ResetDelayRemaining = 0;
+		}
+		if (Phase != PhaseResetting)
+		{
+			ResetFromYaw = ResetFromPitch = ResetPitchOffset = 0;
+		}
+		if (Phase == PhaseIdle || Phase == PhaseWaitingForReset)
+		{
+			Alpha = 0;
+		}
+	}
+
+	bOutSuccess = true;
+	return true;
+}
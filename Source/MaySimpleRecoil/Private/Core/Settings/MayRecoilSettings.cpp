@@ -0,0 +1,18 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/Settings/MayRecoilSettings.h"
+#include "Core/Data/MayRecoilData.h"
+#include "UObject/UObjectIterator.h"
+
+#if WITH_EDITOR
+void UMayRecoilSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// The scale tables of all loaded recoil data are baked from these defaults
+	for (TObjectIterator<UMayRecoilData> It; It; ++It)
+	{
+		It->RebuildBakedData();
+	}
+}
+#endif
@@ -0,0 +1,516 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/Subsystem/MayRecoilSubsystem.h"
+#include "Components/MaySimpleRecoilComponent.h"
+#include "Core/Data/MayRecoilData.h"
+#include "Core/Impl/MayRecoilWorker.h"
+#include "Core/Impl/MayRecoilWorkerObject.h"
+#include "Core/Settings/MayRecoilSettings.h"
+#include "MayRecoilStats.h"
+#include "Algo/Count.h"
+#include "Async/ParallelFor.h"
+
+// ============================================================================
+// Registration
+// ============================================================================
+
+/**
+ * @brief Registers a component and allocates a recoil state for it.
+ *
+ * The index of the state is stored on the component so lookups on the shot path are O(1).
+ */
+void UMayRecoilSubsystem::RegisterComponent(UMaySimpleRecoilComponent* Component)
+{
+	if (!Component) return; // Component must be valid
+	if (Components.IsValidIndex(Component->RecoilStateIndex) && Components[Component->RecoilStateIndex] == Component) return; // Already registered
+
+	Component->RecoilStateIndex = States.AddDefaulted();
+	Components.Add(Component);
+
+	// The worker object starts the reset through its ResetRecoil hook
+	States[Component->RecoilStateIndex].bDeferReset = Component->WorkerMode == EMayRecoilWorkerMode::Object;
+}
+
+/**
+ * @brief Unregisters a component and releases its recoil state.
+ *
+ * The last state is swapped into the freed slot to keep the array contiguous.
+ */
+void UMayRecoilSubsystem::UnregisterComponent(UMaySimpleRecoilComponent* Component)
+{
+	if (!FindState(Component)) return; // Component must be registered
+
+	const int32 Index = Component->RecoilStateIndex;
+	if (States[Index].IsActive())
+	{
+		--NumActiveStates;
+	}
+
+	States.RemoveAtSwap(Index);
+	Components.RemoveAtSwap(Index);
+	Component->RecoilStateIndex = INDEX_NONE;
+
+	// Fix up the index of the state that was moved into the freed slot
+	if (Components.IsValidIndex(Index) && Components[Index])
+	{
+		Components[Index]->RecoilStateIndex = Index;
+	}
+}
+
+/**
+ * @brief Returns the recoil state of a registered component.
+ */
+FMayRecoilState* UMayRecoilSubsystem::FindState(const UMaySimpleRecoilComponent* Component)
+{
+	if (!Component) return nullptr;
+	if (!Components.IsValidIndex(Component->RecoilStateIndex)) return nullptr;
+	if (Components[Component->RecoilStateIndex] != Component) return nullptr;
+
+	return &States[Component->RecoilStateIndex];
+}
+
+// ============================================================================
+// Recoil Functionality
+// ============================================================================
+
+/**
+ * @brief Starts the recoil of a new shot for a registered component.
+ */
+void UMayRecoilSubsystem::Recoil(UMaySimpleRecoilComponent* Component, UMayRecoilData* RecoilData)
+{
+	MAYRECOIL_SCOPE_CYCLE_COUNTER(STAT_MayRecoilRecoil);
+
+	if (!FindState(Component)) return; // Component must be registered
+	if (!RecoilData) return; // RecoilData must be valid
+
+	// Before the shot is generated, the spray may have ended since the last tick
+	AdvanceToCurrentStep(Component->RecoilStateIndex);
+
+	// Looked up after advancing, applying the rotation may register other components
+	FMayRecoilState* State = FindState(Component);
+	if (!State) return; // Component must still be registered
+
+	float Yaw = 0.0f;
+	float Pitch = 0.0f;
+	Component->GenerateShot(RecoilData, Component->CalculateRecoilScale(RecoilData), State->Random, State->PatternIndex, Yaw, Pitch);
+
+	Fire(Component, RecoilData, Yaw, Pitch);
+}
+
+/**
+ * @brief Starts the recoil of a shot with an already calculated strength.
+ */
+void UMayRecoilSubsystem::Fire(UMaySimpleRecoilComponent* Component, UMayRecoilData* RecoilData, float Yaw, float Pitch)
+{
+	if (!FindState(Component)) return; // Component must be registered
+	if (!RecoilData) return; // RecoilData must be valid
+
+	AdvanceToCurrentStep(Component->RecoilStateIndex);
+
+	FMayRecoilState* State = FindState(Component);
+	if (!State) return; // Component must still be registered
+
+	INC_DWORD_STAT(STAT_MayRecoilShots);
+
+	const bool bWasActive = State->IsActive();
+	State->Fire(RecoilData, Yaw, Pitch);
+	if (!bWasActive && State->IsActive())
+	{
+		++NumActiveStates;
+	}
+}
+
+/**
+ * @brief Starts resetting the accumulated recoil of a registered component unless a shot is still being applied.
+ */
+void UMayRecoilSubsystem::BeginReset(UMaySimpleRecoilComponent* Component)
+{
+	FMayRecoilState* State = FindState(Component);
+	if (!State) return; // Component must be registered
+	if (State->Phase == EMayRecoilPhase::Adding) return; // Add phase must not be playing
+
+	MAYRECOIL_SCOPE_CYCLE_COUNTER(STAT_MayRecoilReset);
+	const bool bWasActive = State->IsActive();
+	State->BeginReset();
+	NumActiveStates += static_cast<int32>(State->IsActive()) - static_cast<int32>(bWasActive);
+}
+
+/**
+ * @brief Immediately resets the recoil state of a registered component.
+ */
+void UMayRecoilSubsystem::ResetRecoilState(UMaySimpleRecoilComponent* Component)
+{
+	FMayRecoilState* State = FindState(Component);
+	if (!State) return; // Component must be registered
+
+	if (State->IsActive())
+	{
+		--NumActiveStates;
+	}
+	State->Clear();
+}
+
+/**
+ * @brief Restores the recoil state of a registered component from a packed state.
+ */
+void UMayRecoilSubsystem::RestoreState(UMaySimpleRecoilComponent* Component, const FMayRecoilPackedState& PackedState, UMayRecoilData* RecoilData)
+{
+	FMayRecoilState* State = FindState(Component);
+	if (!State) return; // Component must be registered
+
+	const bool bWasActive = State->IsActive();
+	State->Unpack(PackedState, RecoilData);
+	NumActiveStates += static_cast<int32>(State->IsActive()) - static_cast<int32>(bWasActive);
+
+	const UMayRecoilSettings* Settings = GetDefault<UMayRecoilSettings>();
+	if (Settings->UseFixedStep())
+	{
+		State->StepClock.Sync(GetWorld()->GetTimeSeconds(), Settings->FixedStepRate);
+	}
+}
+
+/**
+ * @brief Advances a state in fixed steps up to the current world time.
+ *
+ * Called before a shot, so the shot starts at the current step instead of the step of the last tick
+ * and the recoil does not depend on how the frames fall between the shots.
+ */
+void UMayRecoilSubsystem::AdvanceToCurrentStep(int32 Index)
+{
+	const UMayRecoilSettings* Settings = GetDefault<UMayRecoilSettings>();
+	if (!Settings->UseFixedStep()) return;
+	if (!States.IsValidIndex(Index)) return; // Index must be valid
+
+	FMayRecoilState& State = States[Index];
+	const bool bWasActive = State.IsActive();
+	const FVector2D Delta = State.AdvanceFixed(GetWorld()->GetTimeSeconds(), Settings->FixedStepRate, Settings->MaxFixedStepsPerFrame);
+	const bool bResetDue = State.ConsumeResetDue();
+	NumActiveStates += static_cast<int32>(State.IsActive()) - static_cast<int32>(bWasActive);
+
+	UMaySimpleRecoilComponent* Component = Components[Index];
+	if (!Delta.IsZero() && Component)
+	{
+		Component->ApplyRecoilYawAndPitch(Delta.X, Delta.Y);
+	}
+	if (bResetDue)
+	{
+		NotifyResetDue(Component);
+	}
+}
+
+/**
+ * @brief Calls the ResetRecoil hook of the worker object of a component whose reset delay expired.
+ */
+void UMayRecoilSubsystem::NotifyResetDue(UMaySimpleRecoilComponent* Component)
+{
+	if (!Component || !Component->RecoilWorkerObject) return; // Worker object must be valid
+
+	Component->RecoilWorkerObject->ResetRecoil();
+}
+
+// ============================================================================
+// Worker Pool
+// ============================================================================
+
+/**
+ * @brief Registers a component that acquires workers of a class, the pool keeps a free worker for it.
+ */
+void UMayRecoilSubsystem::AddWorkerDemand(TSubclassOf<AMayRecoilWorker> WorkerClass)
+{
+	if (!WorkerClass)
+	{
+		WorkerClass = AMayRecoilWorker::StaticClass();
+	}
+
+	FWorkerDemand& Demand = WorkerDemands.FindOrAdd(WorkerClass);
+	++Demand.NumComponents;
+	PrewarmWorkers(WorkerClass, Demand.NumComponents - Demand.NumBoundWorkers);
+}
+
+/**
+ * @brief Unregisters a component registered with AddWorkerDemand.
+ */
+void UMayRecoilSubsystem::RemoveWorkerDemand(TSubclassOf<AMayRecoilWorker> WorkerClass)
+{
+	if (!WorkerClass)
+	{
+		WorkerClass = AMayRecoilWorker::StaticClass();
+	}
+
+	if (FWorkerDemand* Demand = WorkerDemands.Find(WorkerClass))
+	{
+		Demand->NumComponents = FMath::Max(Demand->NumComponents - 1, 0);
+	}
+}
+
+/**
+ * @brief Takes a free worker of the given class from the pool and binds it to a component.
+ */
+AMayRecoilWorker* UMayRecoilSubsystem::AcquireWorker(TSubclassOf<AMayRecoilWorker> WorkerClass, UMaySimpleRecoilComponent* Component)
+{
+	if (!Component) return nullptr; // Component must be valid
+	if (!WorkerClass)
+	{
+		WorkerClass = AMayRecoilWorker::StaticClass();
+	}
+
+	AMayRecoilWorker* Worker = nullptr;
+	for (int32 Index = FreeWorkers.Num() - 1; Index >= 0; --Index)
+	{
+		if (FreeWorkers[Index] && FreeWorkers[Index]->GetClass() == WorkerClass)
+		{
+			Worker = FreeWorkers[Index];
+			FreeWorkers.RemoveAtSwap(Index);
+			break;
+		}
+	}
+
+	if (!Worker)
+	{
+		// Components reserve their worker on BeginPlay, only a worker acquired without AddWorkerDemand gets here
+		UE_LOG(LogTemp, Warning, TEXT("MayRecoil worker pool has no free %s for %s, spawning one. Call AddWorkerDemand for the class before acquiring its workers to avoid the hitch."), *WorkerClass->GetName(), *GetNameSafe(Component->GetOwner()));
+		Worker = SpawnWorker(WorkerClass);
+		if (!Worker) return nullptr;
+	}
+
+	++WorkerDemands.FindOrAdd(WorkerClass).NumBoundWorkers;
+
+	AActor* Owner = Component->GetOwner();
+	Worker->SetOwner(Owner);
+	Worker->SetInstigator(Owner ? Owner->GetInstigator() : nullptr);
+	Worker->SetCurrentComponent(Component);
+	return Worker;
+}
+
+/**
+ * @brief Clears a worker and returns it to the pool.
+ */
+void UMayRecoilSubsystem::ReleaseWorker(AMayRecoilWorker* Worker)
+{
+	if (!IsValid(Worker)) return; // Worker must be valid
+
+	if (FWorkerDemand* Demand = WorkerDemands.Find(Worker->GetClass()))
+	{
+		Demand->NumBoundWorkers = FMath::Max(Demand->NumBoundWorkers - 1, 0);
+	}
+
+	Worker->ResetRecoilState();
+	Worker->SetCurrentComponent(nullptr);
+	Worker->SetCurrentRecoilData(nullptr);
+	Worker->SetOwner(nullptr);
+	Worker->SetInstigator(nullptr);
+	FreeWorkers.AddUnique(Worker);
+}
+
+/**
+ * @brief Spawns free workers until the pool holds the given number of workers of a class.
+ */
+void UMayRecoilSubsystem::PrewarmWorkers(TSubclassOf<AMayRecoilWorker> WorkerClass, int32 Count)
+{
+	if (!WorkerClass) return; // WorkerClass must be valid
+
+	int32 NumFree = 0;
+	for (const AMayRecoilWorker* Worker : FreeWorkers)
+	{
+		NumFree += Worker && Worker->GetClass() == WorkerClass ? 1 : 0;
+	}
+
+	FreeWorkers.Reserve(FreeWorkers.Num() + FMath::Max(Count - NumFree, 0));
+	for (; NumFree < Count; ++NumFree)
+	{
+		AMayRecoilWorker* Worker = SpawnWorker(WorkerClass);
+		if (!Worker) return;
+		FreeWorkers.Add(Worker);
+	}
+}
+
+/**
+ * @brief Destroys free workers until the pool holds at most the given number of workers.
+ */
+void UMayRecoilSubsystem::TrimWorkers(int32 Count)
+{
+	while (FreeWorkers.Num() > FMath::Max(Count, 0))
+	{
+		AMayRecoilWorker* Worker = FreeWorkers.Pop();
+		if (IsValid(Worker))
+		{
+			Worker->Destroy();
+		}
+	}
+}
+
+/**
+ * @brief Spawns a pooled worker.
+ */
+AMayRecoilWorker* UMayRecoilSubsystem::SpawnWorker(TSubclassOf<AMayRecoilWorker> WorkerClass)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.ObjectFlags |= RF_Transient;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	return GetWorld()->SpawnActor<AMayRecoilWorker>(WorkerClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+}
+
+// ============================================================================
+// UWorldSubsystem Interface
+// ============================================================================
+
+/**
+ * @brief Pre-warms the worker pool with the size and class from the project settings.
+ */
+void UMayRecoilSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (!InWorld.IsGameWorld()) return; // Only game worlds fire recoil
+
+	const UMayRecoilSettings* Settings = GetDefault<UMayRecoilSettings>();
+	TSubclassOf<AMayRecoilWorker> WorkerClass = Settings->PooledWorkerClass.LoadSynchronous();
+	PrewarmWorkers(WorkerClass ? WorkerClass : TSubclassOf<AMayRecoilWorker>(AMayRecoilWorker::StaticClass()), Settings->WorkerPoolSize);
+}
+
+// ============================================================================
+// FTickableGameObject Interface
+// ============================================================================
+
+/**
+ * @brief Advances all active recoil states and applies the resulting yaw and pitch.
+ *
+ * The states are advanced first, on worker threads if bParallelUpdate is enabled, and the rotations are applied
+ * on the game thread in a single pass afterwards, because UpdatePlayerYawAndPitch writes to the controller and
+ * may run Blueprint code.
+ * @param DeltaTime Time elapsed since the last frame.
+ */
+void UMayRecoilSubsystem::Tick(float DeltaTime)
+{
+	MAYRECOIL_SCOPE_CYCLE_COUNTER(STAT_MayRecoilSubsystemTick);
+
+	Super::Tick(DeltaTime);
+
+	const UMayRecoilSettings* Settings = GetDefault<UMayRecoilSettings>();
+	const double Time = GetWorld()->GetTimeSeconds();
+
+	const int32 NumStates = States.Num();
+	StateDeltas.SetNumUninitialized(NumStates);
+	StateResetDue.SetNumUninitialized(NumStates);
+	StateSteps.SetNumUninitialized(NumStates);
+
+	if (Settings->bParallelUpdate && NumStates >= Settings->ParallelUpdateMinStates)
+	{
+		// Ranges keep the task overhead below the cost of the states, every task eases with its own batch
+		constexpr int32 RangeSize = 64;
+		const int32 NumRanges = FMath::DivideAndRoundUp(NumStates, RangeSize);
+		if (EaseBatches.Num() < NumRanges)
+		{
+			EaseBatches.SetNum(NumRanges);
+		}
+
+		ParallelFor(TEXT("MayRecoil.AdvanceStates"), NumRanges, 1, [this, DeltaTime, Time, NumStates](int32 RangeIndex)
+		{
+			const int32 Begin = RangeIndex * RangeSize;
+			AdvanceStates(Begin, FMath::Min(Begin + RangeSize, NumStates), DeltaTime, Time, EaseBatches[RangeIndex]);
+		});
+	}
+	else
+	{
+		if (EaseBatches.IsEmpty())
+		{
+			EaseBatches.AddDefaulted();
+		}
+		AdvanceStates(0, NumStates, DeltaTime, Time, EaseBatches[0]);
+	}
+
+	// Callbacks may register or unregister components and move the states, so apply to the components of this tick
+	StateComponents = Components;
+	for (int32 Index = 0; Index < NumStates; ++Index)
+	{
+		const FVector2D& Delta = StateDeltas[Index];
+		if (!Delta.IsZero() && StateComponents[Index])
+		{
+			StateComponents[Index]->ApplyRecoilYawAndPitch(Delta.X, Delta.Y);
+		}
+		if (StateResetDue[Index])
+		{
+			NotifyResetDue(StateComponents[Index]);
+		}
+	}
+
+	// Recount after all callbacks ran, they may have fired or reset other states
+	NumActiveStates = Algo::CountIf(States, [](const FMayRecoilState& State) { return State.IsActive(); });
+	SET_DWORD_STAT(STAT_MayRecoilActiveStates, NumActiveStates);
+}
+
+/**
+ * @brief Advances a range of states and writes their yaw and pitch to StateDeltas.
+ *
+ * The states take their steps together, one round per step (one round without fixed steps). In every round
+ * the add and reset alphas of states without a baked easing table are grouped by their easing settings and
+ * eased four at a time with FMayRecoilEvaluator::EaseAlphaBatch. Baked settings sample their table directly,
+ * which is cheaper than the vectorized functions and keeps the states in step with FMayRecoilSimulation.
+ */
+void UMayRecoilSubsystem::AdvanceStates(int32 Begin, int32 End, float DeltaTime, double Time, FMayRecoilEaseBatch& Batch)
+{
+	const UMayRecoilSettings* Settings = GetDefault<UMayRecoilSettings>();
+	const bool bFixedStep = Settings->UseFixedStep();
+	const float StepTime = bFixedStep ? 1.0f / Settings->FixedStepRate : DeltaTime;
+
+	// Idle states take no steps, see FMayRecoilState::AdvanceFixed
+	int32 NumRounds = 0;
+	for (int32 Index = Begin; Index < End; ++Index)
+	{
+		FMayRecoilState& State = States[Index];
+		StateDeltas[Index] = FVector2D::ZeroVector;
+		StateSteps[Index] = !State.IsActive() ? 0 :
+			bFixedStep ? State.StepClock.Consume(Time, Settings->FixedStepRate, Settings->MaxFixedStepsPerFrame) : 1;
+		NumRounds = FMath::Max(NumRounds, StateSteps[Index]);
+	}
+
+	for (int32 Round = 0; Round < NumRounds; ++Round)
+	{
+		Batch.Reset();
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			FMayRecoilState& State = States[Index];
+			if (Round >= StateSteps[Index] || !State.IsActive()) continue;
+
+			FMayRecoilEasing Easing;
+			if (!State.BeginEasedStep(StepTime, Easing))
+			{
+				StateDeltas[Index] += State.Advance(StepTime);
+			}
+			else if (Easing.IsBaked())
+			{
+				StateDeltas[Index] += State.FinishEasedStep(Easing.Table->Sample(State.Alpha));
+			}
+			else
+			{
+				Batch.Add(Index, State.Alpha, Easing);
+			}
+		}
+
+		Batch.Ease();
+		for (const FMayRecoilEaseBatch::FGroup& Group : Batch.GetGroups())
+		{
+			for (int32 Item = 0; Item < Group.Items.Num(); ++Item)
+			{
+				const int32 Index = Group.Items[Item];
+				StateDeltas[Index] += States[Index].FinishEasedStep(Group.Eased[Item]);
+			}
+		}
+	}
+
+	for (int32 Index = Begin; Index < End; ++Index)
+	{
+		StateResetDue[Index] = StateSteps[Index] > 0 && States[Index].ConsumeResetDue();
+	}
+}
+
+bool UMayRecoilSubsystem::IsTickable() const
+{
+	return NumActiveStates > 0;
+}
+
+TStatId UMayRecoilSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UMayRecoilSubsystem, STATGROUP_Tickables);
+}
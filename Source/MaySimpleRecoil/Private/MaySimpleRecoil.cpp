@@ -1,18 +1,51 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "MaySimpleRecoil.h"
+#include "MayRecoilStats.h"
+
+#if WITH_GAMEPLAY_DEBUGGER
+#include "GameplayDebugger.h"
+#include "Core/Debug/GameplayDebuggerCategory_MayRecoil.h"
+#endif
+
+DEFINE_STAT(STAT_MayRecoilAwakeWorkers);
+DEFINE_STAT(STAT_MayRecoilActiveStates);
+DEFINE_STAT(STAT_MayRecoilShots);
+DEFINE_STAT(STAT_MayRecoilResetRestarts);
+DEFINE_STAT(STAT_MayRecoilRecoil);
+DEFINE_STAT(STAT_MayRecoilGenerateShot);
+DEFINE_STAT(STAT_MayRecoilWorkerTick);
+DEFINE_STAT(STAT_MayRecoilSubsystemTick);
+DEFINE_STAT(STAT_MayRecoilUpdatePlayer);
+DEFINE_STAT(STAT_MayRecoilReset);
+DEFINE_STAT(STAT_MayRecoilAdvancePhases);
 
 #define LOCTEXT_NAMESPACE "FMaySimpleRecoilModule"
 
 void FMaySimpleRecoilModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+#if WITH_GAMEPLAY_DEBUGGER
+	IGameplayDebugger& GameplayDebuggerModule = IGameplayDebugger::Get();
+	GameplayDebuggerModule.RegisterCategory("MayRecoil",
+		IGameplayDebugger::FOnGetCategory::CreateStatic(&FGameplayDebuggerCategory_MayRecoil::MakeInstance),
+		EGameplayDebuggerCategoryState::EnabledInGameAndSimulate);
+	GameplayDebuggerModule.NotifyCategoriesChanged();
+#endif
 }
 
 void FMaySimpleRecoilModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+#if WITH_GAMEPLAY_DEBUGGER
+	if (IGameplayDebugger::IsAvailable())
+	{
+		IGameplayDebugger& GameplayDebuggerModule = IGameplayDebugger::Get();
+		GameplayDebuggerModule.UnregisterCategory("MayRecoil");
+		GameplayDebuggerModule.NotifyCategoriesChanged();
+	}
+#endif
 }
 
 #undef LOCTEXT_NAMESPACE
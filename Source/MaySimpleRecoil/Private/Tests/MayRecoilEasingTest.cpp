@@ -0,0 +1,240 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Core/Data/MayRecoilData.h"
+#include "Core/Data/MayRecoilState.h"
+#include "Core/Impl/MayRecoilEvaluator.h"
+#include "Core/Subsystem/MayRecoilSubsystem.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Tests/MayRecoilTestHelpers.h"
+
+namespace MayRecoilEasingTest
+{
+	/** Blend exponents covered by the tests, including the ones outside 1..6 that must not be baked. */
+	static const float BlendExps[] = { 0.5f, 1.0f, 2.0f, 4.0f, 6.0f, 8.0f };
+
+	/** Number of steps of the Step function. */
+	static constexpr int32 Steps = 4;
+
+	/** Number of alphas sampled between 0 and 1. */
+	static constexpr int32 NumSamples = 4096;
+
+	/** Maximum absolute error of the vectorized easing against the scalar one. */
+	static constexpr float BatchTolerance = 1.0e-4f;
+
+	/** Calls Function for every easing function with its display name. */
+	template <typename FunctionType>
+	static void ForEachEasingFunc(FunctionType&& Function)
+	{
+		const UEnum* EasingEnum = StaticEnum<EEasingFunc::Type>();
+		for (int32 EnumIndex = 0; EnumIndex < EasingEnum->NumEnums() - 1; ++EnumIndex)
+		{
+			Function(static_cast<EEasingFunc::Type>(EasingEnum->GetValueByIndex(EnumIndex)), EasingEnum->GetNameStringByIndex(EnumIndex));
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMayRecoilEaseAlphaTest, "MayRecoil.Easing.EaseAlpha",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/**
+ * FMayRecoilEvaluator::EaseAlpha must match UKismetMathLibrary::Ease, which the worker used before.
+ */
+bool FMayRecoilEaseAlphaTest::RunTest(const FString& Parameters)
+{
+	using namespace MayRecoilEasingTest;
+
+	ForEachEasingFunc([this](EEasingFunc::Type EasingFunc, const FString& Name)
+	{
+		for (const float BlendExp : BlendExps)
+		{
+			for (int32 Index = 0; Index <= NumSamples; ++Index)
+			{
+				const float Alpha = static_cast<float>(Index) / NumSamples;
+				const float Reference = UKismetMathLibrary::Ease(0.0f, 1.0f, Alpha, EasingFunc, BlendExp, Steps);
+				const float Eased = FMayRecoilEvaluator::EaseAlpha(Alpha, EasingFunc, BlendExp, Steps);
+				if (!TestEqual(FString::Printf(TEXT("%s (BlendExp %.1f) at %f"), *Name, BlendExp, Alpha), Eased, Reference, UE_KINDA_SMALL_NUMBER))
+				{
+					return;
+				}
+			}
+		}
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMayRecoilEasingTableTest, "MayRecoil.Easing.Table",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/**
+ * Every table that is baked must stay within FMayRecoilEasingTable::MaxBakeError of the direct evaluation.
+ */
+bool FMayRecoilEasingTableTest::RunTest(const FString& Parameters)
+{
+	using namespace MayRecoilEasingTest;
+
+	ForEachEasingFunc([this](EEasingFunc::Type EasingFunc, const FString& Name)
+	{
+		for (const float BlendExp : BlendExps)
+		{
+			FMayRecoilEasingTable Table;
+			Table.Bake(EasingFunc, BlendExp, Steps);
+			TestEqual(FString::Printf(TEXT("%s (BlendExp %.1f) baked"), *Name, BlendExp), Table.bBaked, FMayRecoilEasingTable::CanBake(EasingFunc, BlendExp));
+
+			float MaxError = 0.0f;
+			for (int32 Index = 0; Index <= NumSamples; ++Index)
+			{
+				const float Alpha = static_cast<float>(Index) / NumSamples;
+				const float Reference = FMayRecoilEvaluator::EaseAlpha(Alpha, EasingFunc, BlendExp, Steps);
+				const float Sampled = FMayRecoilEvaluator::EaseAlpha(Table, Alpha, EasingFunc, BlendExp, Steps);
+				MaxError = FMath::Max(MaxError, FMath::Abs(Reference - Sampled));
+			}
+
+			TestTrue(FString::Printf(TEXT("%s (BlendExp %.1f) max error %f within %f"), *Name, BlendExp, MaxError, FMayRecoilEasingTable::MaxBakeError),
+				MaxError <= FMayRecoilEasingTable::MaxBakeError);
+		}
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMayRecoilEaseAlphaBatchTest, "MayRecoil.Easing.Batch",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/**
+ * FMayRecoilEvaluator::EaseAlphaBatch must match the scalar EaseAlpha for every easing function,
+ * in the vectorized part as well as in the scalar tail.
+ */
+bool FMayRecoilEaseAlphaBatchTest::RunTest(const FString& Parameters)
+{
+	using namespace MayRecoilEasingTest;
+
+	// Odd count so the last alpha takes the scalar tail, both ends and the InOut midpoint are included
+	TArray<float> Alphas;
+	Alphas.SetNumUninitialized(NumSamples + 1);
+	for (int32 Index = 0; Index <= NumSamples; ++Index)
+	{
+		Alphas[Index] = static_cast<float>(Index) / NumSamples;
+	}
+
+	TArray<float> Eased;
+	Eased.SetNumUninitialized(Alphas.Num());
+
+	ForEachEasingFunc([this, &Alphas, &Eased](EEasingFunc::Type EasingFunc, const FString& Name)
+	{
+		for (const float BlendExp : BlendExps)
+		{
+			// A single step stays at the start
+			for (const int32 NumSteps : { 1, Steps })
+			{
+				FMayRecoilEvaluator::EaseAlphaBatch(Alphas, Eased, EasingFunc, BlendExp, NumSteps);
+
+				float MaxError = 0.0f;
+				for (int32 Index = 0; Index < Alphas.Num(); ++Index)
+				{
+					// Also catches NaN of a lane that should have been masked out
+					const float Error = FMath::Abs(Eased[Index] - FMayRecoilEvaluator::EaseAlpha(Alphas[Index], EasingFunc, BlendExp, NumSteps));
+					MaxError = FMath::IsFinite(Error) ? FMath::Max(MaxError, Error) : MAX_flt;
+				}
+
+				TestTrue(FString::Printf(TEXT("%s (BlendExp %.1f, %d steps) max error %f within %f"), *Name, BlendExp, NumSteps, MaxError, BatchTolerance),
+					MaxError <= BatchTolerance);
+			}
+		}
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMayRecoilEaseBatchStatesTest, "MayRecoil.Easing.BatchStates",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/**
+ * States of components in Subsystem mode, advanced by UMayRecoilSubsystem with their alphas eased together in an
+ * FMayRecoilEaseBatch, must apply the same recoil as states advanced one at a time with FMayRecoilState::Advance.
+ */
+bool FMayRecoilEaseBatchStatesTest::RunTest(const FString& Parameters)
+{
+	using namespace MayRecoilEasingTest;
+
+	constexpr int32 NumStates = 37;
+	constexpr float DeltaTime = 1.0f / 60.0f;
+	constexpr int32 NumFrames = 120;
+
+	// Unbaked settings that are batched, next to baked ones that sample their table
+	UMayRecoilData* CircularData = MayRecoilTest::MakeRecoilData(false, false);
+	CircularData->RecoilInterpolation = EEasingFunc::CircularInOut;
+	CircularData->RecoilResetInterpolation = EEasingFunc::CircularOut;
+	CircularData->RebuildBakedData();
+
+	UMayRecoilData* SteepData = MayRecoilTest::MakeRecoilData(false, false);
+	SteepData->RecoilInterpolationEaseExp = 8.0f;
+	SteepData->RebuildBakedData();
+
+	UMayRecoilData* BakedData = MayRecoilTest::MakeRecoilData(false, false);
+	UMayRecoilData* DataAssets[] = { CircularData, SteepData, BakedData };
+	for (UMayRecoilData* Data : DataAssets)
+	{
+		Data->RecoilResetDelay = 0.1f;
+	}
+
+	// The subsystem steps by the frame time, like the reference states
+	const MayRecoilTest::FScopedFixedStepRate FixedStepRate(0.0f);
+	MayRecoilTest::FTestWorld TestWorld;
+	UMayRecoilSubsystem* RecoilSubsystem = TestWorld.GetWorld()->GetSubsystem<UMayRecoilSubsystem>();
+	if (!TestNotNull(TEXT("Recoil subsystem"), RecoilSubsystem)) return true;
+
+	TArray<UMaySimpleRecoilComponent*> Components;
+	for (int32 Index = 0; Index < NumStates; ++Index)
+	{
+		Components.Add(TestWorld.SpawnRecoilCharacter(DataAssets[Index % UE_ARRAY_COUNT(DataAssets)], EMayRecoilWorkerMode::Subsystem, Index + 1));
+	}
+
+	TArray<FMayRecoilState> Reference;
+	TArray<FVector2D> ReferenceApplied;
+	Reference.SetNum(NumStates);
+	ReferenceApplied.Init(FVector2D::ZeroVector, NumStates);
+
+	double MaxError = 0.0;
+	int32 NumPhaseMismatches = 0;
+
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		// Shots at different times, so the states are spread over all phases
+		for (int32 Index = 0; Index < NumStates; ++Index)
+		{
+			if ((Frame + Index) % 40 == 0)
+			{
+				UMayRecoilData* Data = DataAssets[Index % UE_ARRAY_COUNT(DataAssets)];
+				const float Yaw = 0.1f * (Index % 7) - 0.3f;
+				const float Pitch = -1.0f - 0.05f * Index;
+				Reference[Index].Fire(Data, Yaw, Pitch);
+				if (FMayRecoilState* State = RecoilSubsystem->FindState(Components[Index]))
+				{
+					State->Fire(Data, Yaw, Pitch);
+				}
+			}
+		}
+
+		TestWorld.Tick(DeltaTime);
+
+		for (int32 Index = 0; Index < NumStates; ++Index)
+		{
+			const FMayRecoilState* State = RecoilSubsystem->FindState(Components[Index]);
+			if (!TestNotNull(TEXT("Registered state"), State)) return true;
+
+			ReferenceApplied[Index] += Reference[Index].IsActive() ? Reference[Index].Advance(DeltaTime) : FVector2D::ZeroVector;
+			const FVector2D Applied = MayRecoilTest::FTestWorld::GetAppliedYawAndPitch(Components[Index]);
+			MaxError = FMath::Max(MaxError, (Applied - ReferenceApplied[Index]).GetAbsMax());
+			MaxError = FMath::Max(MaxError, (State->AddedPitchAndYaw - Reference[Index].AddedPitchAndYaw).GetAbsMax());
+			NumPhaseMismatches += State->Phase != Reference[Index].Phase ? 1 : 0;
+		}
+	}
+
+	TestEqual(TEXT("Batched states in a different phase"), NumPhaseMismatches, 0);
+	TestTrue(FString::Printf(TEXT("Batched states max error %f within %f"), MaxError, BatchTolerance), MaxError <= BatchTolerance);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
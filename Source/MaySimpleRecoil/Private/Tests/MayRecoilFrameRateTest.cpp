@@ -0,0 +1,280 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Core/Data/MayRecoilData.h"
+#include "Core/Impl/MayRecoilSimulation.h"
+#include "Core/Settings/MayRecoilSettings.h"
+#include "Engine/World.h"
+#include "Tests/MayRecoilTestHelpers.h"
+
+namespace MayRecoilFrameRateTest
+{
+	/** 20 Hz is the server, the other rates are clients. */
+	static const int32 FrameRates[] = { 20, 30, 60, 144, 240 };
+
+	static constexpr float StepRate = 120.0f;
+	static constexpr double Tolerance = 1.0e-4;
+	static constexpr int32 Seed = 1234;
+
+	/** Spray of NumShots shots, one every ShotInterval seconds. */
+	static constexpr int32 NumShots = 10;
+	static constexpr double ShotInterval = 0.1;
+
+	/** Length of the sprays, sampled every half second. */
+	static constexpr double Duration = 4.0;
+
+	/** Time after the spray at which the player starts to move the mouse, and for how long. */
+	static constexpr double RecoveryStart = 2.0;
+	static constexpr double RecoveryDuration = 0.5;
+
+	/** Yaw input of the player while recovering, any value other than 0 decays the yaw. */
+	static constexpr float PlayerYaw = 1.0f;
+
+	/** Pitch the player pulls up per second while recovering. */
+	static constexpr float PlayerPitchSpeed = 0.5f;
+
+	/** @return Whether the next shot of the spray is due at the given frame time. Shots fire on the first frame at or after their time. */
+	static bool IsShotDue(int32 NextShot, double Time)
+	{
+		return NextShot < NumShots && Time + 1.0e-6 >= (NextShot + 1) * ShotInterval;
+	}
+
+	/** Simulates the spray with FMayRecoilSimulation::SimulateFrame and returns the accumulated yaw and pitch every half second. */
+	static TArray<FVector2D> SimulateSpray(UMayRecoilData* Data, int32 FrameRate, float InStepRate)
+	{
+		FMayRecoilState State;
+		FVector2D Accumulated = FVector2D::ZeroVector;
+		TArray<FVector2D> Samples;
+
+		const int32 FramesPerSample = FrameRate / 2;
+		const int32 NumFrames = FMath::RoundToInt(Duration * FrameRate);
+		const float DeltaTime = 1.0f / FrameRate;
+		int32 NextShot = 0;
+
+		for (int32 Frame = 1; Frame <= NumFrames; ++Frame)
+		{
+			const double Time = static_cast<double>(Frame) / FrameRate;
+
+			FMayRecoilFrameInput Input;
+			if (IsShotDue(NextShot, Time))
+			{
+				Input.FireRecoilData = Data;
+				++NextShot;
+			}
+
+			Accumulated += FMayRecoilSimulation::SimulateFrame(State, Seed, Input, Time, DeltaTime, InStepRate, MAX_int32);
+
+			if (Frame % FramesPerSample == 0)
+			{
+				Samples.Add(Accumulated);
+			}
+		}
+		return Samples;
+	}
+
+	/**
+	 * Runs the spray through a recoil component in Actor mode, whose worker advances in AMayRecoilWorker::AdvanceFixedSteps,
+	 * and returns the yaw and pitch applied to the control rotation every half second.
+	 */
+	static TArray<FVector2D> RunWorkerSpray(UMayRecoilData* Data, int32 FrameRate)
+	{
+		MayRecoilTest::FTestWorld TestWorld;
+		UMaySimpleRecoilComponent* Component = TestWorld.SpawnRecoilCharacter(Data, EMayRecoilWorkerMode::Actor, Seed);
+		TArray<FVector2D> Samples;
+
+		const int32 FramesPerSample = FrameRate / 2;
+		const int32 NumFrames = FMath::RoundToInt(Duration * FrameRate);
+		const float DeltaTime = 1.0f / FrameRate;
+		int32 NextShot = 0;
+
+		for (int32 Frame = 1; Frame <= NumFrames; ++Frame)
+		{
+			// The world advances the worker up to the frame time, the shot starts there like in SimulateFrame
+			TestWorld.Tick(DeltaTime);
+			if (IsShotDue(NextShot, TestWorld.GetWorld()->GetTimeSeconds()))
+			{
+				Component->Recoil();
+				++NextShot;
+			}
+
+			if (Frame % FramesPerSample == 0)
+			{
+				Samples.Add(MayRecoilTest::FTestWorld::GetAppliedYawAndPitch(Component));
+			}
+		}
+		return Samples;
+	}
+
+	/** @return The largest difference of two sample sequences, or a large value if they differ in length. */
+	static double GetMaxError(const TArray<FVector2D>& Samples, const TArray<FVector2D>& Reference)
+	{
+		if (Samples.Num() != Reference.Num()) return UE_BIG_NUMBER;
+
+		double MaxError = 0.0;
+		for (int32 Index = 0; Index < Reference.Num(); ++Index)
+		{
+			MaxError = FMath::Max(MaxError, (Samples[Index] - Reference[Index]).GetAbsMax());
+		}
+		return MaxError;
+	}
+
+	/** Creates the recoil data of the sweep. A long reset delay keeps the recoil of the spray until the recovery is over. */
+	static UMayRecoilData* MakeSweepRecoilData(float ResetDelay)
+	{
+		UMayRecoilData* Data = MayRecoilTest::MakeRecoilData(false, false);
+		Data->RecoilResetDelay = ResetDelay;
+		return Data;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMayRecoilFrameRateSimulationTest, "MayRecoil.FrameRate.Simulation",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/**
+ * With fixed steps, FMayRecoilSimulation::SimulateFrame must apply the same recoil at every frame rate as on the 20 Hz server.
+ */
+bool FMayRecoilFrameRateSimulationTest::RunTest(const FString& Parameters)
+{
+	using namespace MayRecoilFrameRateTest;
+
+	UMayRecoilData* Data = MakeSweepRecoilData(0.05f);
+	const TArray<FVector2D> VariableReference = SimulateSpray(Data, FrameRates[0], 0.0f);
+	const TArray<FVector2D> FixedReference = SimulateSpray(Data, FrameRates[0], StepRate);
+
+	for (const int32 FrameRate : FrameRates)
+	{
+		// Without fixed steps the recoil depends on the frame rate, only logged for comparison
+		AddInfo(FString::Printf(TEXT("%d fps variable step max error: %f"), FrameRate, GetMaxError(SimulateSpray(Data, FrameRate, 0.0f), VariableReference)));
+
+		const double FixedError = GetMaxError(SimulateSpray(Data, FrameRate, StepRate), FixedReference);
+		TestTrue(FString::Printf(TEXT("%d fps fixed step max error %f within %f"), FrameRate, FixedError, Tolerance), FixedError <= Tolerance);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMayRecoilFrameRateWorkerTest, "MayRecoil.FrameRate.ActorWorker",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/**
+ * With fixed steps, the worker of a component in Actor mode must apply the same recoil at every frame rate as on the 20 Hz server.
+ */
+bool FMayRecoilFrameRateWorkerTest::RunTest(const FString& Parameters)
+{
+	using namespace MayRecoilFrameRateTest;
+
+	const MayRecoilTest::FScopedFixedStepRate FixedStepRate(StepRate);
+
+	UMayRecoilData* Data = MakeSweepRecoilData(0.05f);
+	const TArray<FVector2D> Reference = RunWorkerSpray(Data, FrameRates[0]);
+	TestTrue(TEXT("Worker applied recoil"), Reference.Num() > 1 && !Reference[1].IsNearlyZero());
+
+	for (const int32 FrameRate : FrameRates)
+	{
+		const double Error = GetMaxError(RunWorkerSpray(Data, FrameRate), Reference);
+		TestTrue(FString::Printf(TEXT("%d fps max error %f within %f"), FrameRate, Error, Tolerance), Error <= Tolerance);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMayRecoilFrameRateRecoveryTest, "MayRecoil.FrameRate.PlayerRecovery",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/**
+ * Yaw and pitch input of the player must recover the same amount of recoil over the same time at every frame rate,
+ * in FMayRecoilSimulation::SimulateFrame and in the worker of a component in Actor mode.
+ */
+bool FMayRecoilFrameRateRecoveryTest::RunTest(const FString& Parameters)
+{
+	using namespace MayRecoilFrameRateTest;
+
+	const MayRecoilTest::FScopedFixedStepRate FixedStepRate(StepRate);
+	const float RecoverySpeed = GetDefault<UMayRecoilSettings>()->PlayerYawRecoverySpeed;
+	UMayRecoilData* Data = MakeSweepRecoilData(5.0f);
+
+	// Recoil left after the recovery, expected from the recoil at its start
+	auto TestRecovery = [this, RecoverySpeed](const FString& What, const FVector2D& Start, const FVector2D& End)
+	{
+		const FVector2D Expected(Start.X * FMath::Exp(-RecoverySpeed * RecoveryDuration), FMath::Min(Start.Y + PlayerPitchSpeed * RecoveryDuration, 0.0));
+		TestTrue(What + TEXT(" has yaw to recover"), !FMath::IsNearlyZero(Start.X));
+		TestEqual(What + TEXT(" recovered yaw"), End.X, Expected.X, Tolerance);
+		TestEqual(What + TEXT(" recovered pitch"), End.Y, Expected.Y, Tolerance);
+	};
+
+	for (const int32 FrameRate : FrameRates)
+	{
+		const int32 NumFrames = FMath::RoundToInt((RecoveryStart + RecoveryDuration) * FrameRate);
+		const int32 RecoveryFrame = FMath::RoundToInt(RecoveryStart * FrameRate);
+		const float DeltaTime = 1.0f / FrameRate;
+
+		// Simulation
+		{
+			FMayRecoilState State;
+			FVector2D Start = FVector2D::ZeroVector;
+			int32 NextShot = 0;
+
+			for (int32 Frame = 1; Frame <= NumFrames; ++Frame)
+			{
+				const double Time = static_cast<double>(Frame) / FrameRate;
+
+				FMayRecoilFrameInput Input;
+				if (IsShotDue(NextShot, Time))
+				{
+					Input.FireRecoilData = Data;
+					++NextShot;
+				}
+				else if (Frame > RecoveryFrame)
+				{
+					Input.PlayerYaw = PlayerYaw;
+					Input.PlayerPitch = PlayerPitchSpeed * DeltaTime;
+				}
+
+				FMayRecoilSimulation::SimulateFrame(State, Seed, Input, Time, DeltaTime, StepRate, MAX_int32);
+
+				if (Frame == RecoveryFrame)
+				{
+					Start = State.AddedPitchAndYaw;
+				}
+			}
+			TestRecovery(FString::Printf(TEXT("Simulation at %d fps"), FrameRate), Start, State.AddedPitchAndYaw);
+		}
+
+		// Actor worker
+		{
+			MayRecoilTest::FTestWorld TestWorld;
+			UMaySimpleRecoilComponent* Component = TestWorld.SpawnRecoilCharacter(Data, EMayRecoilWorkerMode::Actor, Seed);
+			FVector2D Start = FVector2D::ZeroVector;
+			int32 NextShot = 0;
+
+			for (int32 Frame = 1; Frame <= NumFrames; ++Frame)
+			{
+				TestWorld.Tick(DeltaTime);
+				if (IsShotDue(NextShot, TestWorld.GetWorld()->GetTimeSeconds()))
+				{
+					Component->Recoil();
+					++NextShot;
+				}
+				else if (Frame > RecoveryFrame)
+				{
+					Component->OnYawAdded(PlayerYaw);
+					Component->OnPitchAdded(PlayerPitchSpeed * DeltaTime);
+				}
+
+				if (Frame == RecoveryFrame && Component->RecoilWorkerInstance)
+				{
+					Start = Component->RecoilWorkerInstance->GetAddedPitchAndYaw();
+				}
+			}
+
+			if (TestNotNull(TEXT("Recoil worker"), Component->RecoilWorkerInstance))
+			{
+				TestRecovery(FString::Printf(TEXT("Actor worker at %d fps"), FrameRate), Start, Component->RecoilWorkerInstance->GetAddedPitchAndYaw());
+			}
+		}
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
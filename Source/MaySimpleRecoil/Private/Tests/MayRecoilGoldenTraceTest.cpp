@@ -0,0 +1,320 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Core/Data/MayRecoilData.h"
+#include "Core/Impl/MayRecoilSimulation.h"
+#include "Core/Impl/MayRecoilWorker.h"
+#include "Curves/CurveFloat.h"
+#include "Engine/World.h"
+#include "Tests/MayRecoilTestHelpers.h"
+
+namespace MayRecoilGoldenTraceTest
+{
+	static constexpr int32 Seed = 1234;
+	static constexpr double Tolerance = 1.0e-4;
+
+	/** Every script fires NumShots shots, one every FramesPerShot frames, and runs NumFrames frames at 60 fps. */
+	static constexpr int32 NumShots = 15;
+	static constexpr int32 FramesPerShot = 6;
+	static constexpr int32 NumFrames = 240;
+	static constexpr float DeltaTime = 1.0f / 60.0f;
+
+	/** The applied yaw (X) and pitch (Y) are sampled every SampleInterval frames. */
+	static constexpr int32 SampleInterval = 10;
+
+	// ============================================================================
+	// Golden Traces
+	// ============================================================================
+
+	// Applied yaw (X) and pitch (Y) at frames 9, 19, ..., 239 of each script, the same in every worker mode.
+	// A failing test logs the current trace in this format.
+
+	static const FVector2D RandomTrace[] =
+	{
+		FVector2D(0.104430, -0.439881), FVector2D(0.153955, -0.848173), FVector2D(0.181093, -1.473479), FVector2D(0.203306, -1.797330),
+		FVector2D(0.221144, -2.189951), FVector2D(0.376568, -2.678226), FVector2D(0.422923, -3.110023), FVector2D(0.462183, -3.603694),
+		FVector2D(0.426687, -4.148281), FVector2D(0.295650, -5.292405), FVector2D(0.267586, -5.149131), FVector2D(0.223790, -4.306370),
+		FVector2D(0.183924, -3.539245), FVector2D(0.147962, -2.847228), FVector2D(0.115894, -2.230144), FVector2D(0.087757, -1.688697),
+		FVector2D(0.063522, -1.222358), FVector2D(0.043182, -0.830949), FVector2D(0.026772, -0.515179), FVector2D(0.014266, -0.274515),
+		FVector2D(0.005653, -0.108784), FVector2D(0.000971, -0.018689), FVector2D(0.000000, 0.000000), FVector2D(0.000000, 0.000000),
+	};
+
+	static const FVector2D PatternTrace[] =
+	{
+		FVector2D(-0.013580, -0.290105), FVector2D(0.015298, -0.712027), FVector2D(0.018109, -1.375165), FVector2D(-0.003693, -1.642064),
+		FVector2D(0.022017, -2.060852), FVector2D(0.037657, -2.696583), FVector2D(0.018269, -2.985072), FVector2D(0.046121, -3.424070),
+		FVector2D(0.042669, -4.071063), FVector2D(0.621440, -5.557623), FVector2D(0.650348, -5.436505), FVector2D(0.543905, -4.546709),
+		FVector2D(0.447015, -3.736771), FVector2D(0.359612, -3.006133), FVector2D(0.281673, -2.354609), FVector2D(0.213286, -1.782944),
+		FVector2D(0.154387, -1.290578), FVector2D(0.104951, -0.877325), FVector2D(0.065068, -0.543931), FVector2D(0.034672, -0.289836),
+		FVector2D(0.013740, -0.114855), FVector2D(0.002360, -0.019732), FVector2D(0.000000, 0.000000), FVector2D(0.000000, 0.000000),
+	};
+
+	static const FVector2D AccumulateTrace[] =
+	{
+		FVector2D(0.545464, -2.236801), FVector2D(0.836503, -4.562780), FVector2D(1.066517, -7.562048), FVector2D(1.148458, -9.768976),
+		FVector2D(1.203372, -12.021397), FVector2D(1.937556, -14.515270), FVector2D(2.406793, -17.079496), FVector2D(2.528830, -19.822705),
+		FVector2D(2.426153, -22.540959), FVector2D(2.252602, -21.899948), FVector2D(1.883917, -18.315570), FVector2D(1.548321, -15.052885),
+		FVector2D(1.245583, -12.109645), FVector2D(0.975626, -9.485104), FVector2D(0.738758, -7.182256), FVector2D(0.534747, -5.198851),
+		FVector2D(0.363517, -3.534140), FVector2D(0.225376, -2.191124), FVector2D(0.120093, -1.167551), FVector2D(0.047590, -0.462673),
+		FVector2D(0.008176, -0.079487), FVector2D(0.000000, 0.000000), FVector2D(0.000000, 0.000000), FVector2D(0.000000, 0.000000),
+	};
+
+	static const FVector2D PullDownTrace[] =
+	{
+		FVector2D(0.104430, -0.439881), FVector2D(0.153955, -0.848173), FVector2D(0.181093, -1.473479), FVector2D(0.203306, -1.797330),
+		FVector2D(0.221144, -2.189951), FVector2D(0.376568, -2.678226), FVector2D(0.422923, -3.110023), FVector2D(0.462183, -3.603694),
+		FVector2D(0.426687, -4.148281), FVector2D(0.295650, -5.292405), FVector2D(0.267586, -5.149131), FVector2D(0.223790, -4.306370),
+		FVector2D(0.183924, -3.539245), FVector2D(0.151272, -2.910922), FVector2D(0.126321, -2.430788), FVector2D(0.105568, -2.031436),
+		FVector2D(0.088413, -1.701322), FVector2D(0.074296, -1.429675), FVector2D(0.062488, -1.202462), FVector2D(0.052577, -1.011738),
+		FVector2D(0.044325, -0.852946), FVector2D(0.037391, -0.719514), FVector2D(0.031545, -0.607010), FVector2D(0.026636, -0.512551),
+	};
+
+	/** Scripted shot sequence and its golden traces. */
+	struct FGoldenScript
+	{
+		const TCHAR* Name;
+		bool bStaticPattern;
+		bool bAccumulateShots;
+
+		/** Pitch the player pulls down every frame after the last shot, restarts the reset. */
+		float PlayerPitch;
+
+		/** Trace of FMayRecoilSimulation, the subsystem and AMayRecoilWorker. */
+		TConstArrayView<FVector2D> Golden;
+	};
+
+	static const FGoldenScript Scripts[] =
+	{
+		{ TEXT("Random"), false, false, 0.0f, RandomTrace },
+		{ TEXT("Pattern"), true, false, 0.0f, PatternTrace },
+		{ TEXT("Accumulate"), false, true, 0.0f, AccumulateTrace },
+		{ TEXT("PullDown"), false, false, -0.2f, PullDownTrace },
+	};
+
+	// ============================================================================
+	// Helpers
+	// ============================================================================
+
+	static bool IsShotFrame(int32 Frame)
+	{
+		return Frame % FramesPerShot == 0 && Frame / FramesPerShot < NumShots;
+	}
+
+	static bool IsSampleFrame(int32 Frame)
+	{
+		return Frame % SampleInterval == SampleInterval - 1;
+	}
+
+	/** Creates the recoil data of a script. The scale is fixed, so the traces do not depend on the project settings. */
+	static UMayRecoilData* MakeScriptRecoilData(const FGoldenScript& Script)
+	{
+		UMayRecoilData* Data = MayRecoilTest::MakeRecoilData(Script.bStaticPattern, Script.bAccumulateShots);
+		Data->OverrideScaleSettings = true;
+		Data->RecoilScale = 1.0f;
+		Data->RecoilScaleSprint = 1.0f;
+		Data->RecoilScaleCrouch = 1.0f;
+		Data->RecoilScaleJump = 1.0f;
+		Data->RecoilScaleADS = 1.0f;
+		Data->RebuildBakedData();
+		return Data;
+	}
+
+	/** Runs a script through FMayRecoilSimulation::Step and returns the accumulated yaw and pitch. */
+	static TArray<FVector2D> RunSimulation(const FGoldenScript& Script)
+	{
+		UMayRecoilData* Data = MakeScriptRecoilData(Script);
+
+		FMayRecoilState State;
+		FVector2D Accumulated = FVector2D::ZeroVector;
+		TArray<FVector2D> Samples;
+
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			FMayRecoilFrameInput Input;
+			if (IsShotFrame(Frame))
+			{
+				Input.FireRecoilData = Data;
+			}
+			else if (Frame > NumShots * FramesPerShot)
+			{
+				Input.PlayerPitch = Script.PlayerPitch;
+			}
+
+			Accumulated += FMayRecoilSimulation::Step(State, Seed, Input, DeltaTime);
+
+			if (IsSampleFrame(Frame))
+			{
+				Samples.Add(Accumulated);
+			}
+		}
+		return Samples;
+	}
+
+	/** Creates a linear 0..1 curve of one second, the curve the native playbacks of the worker replace. */
+	static UCurveFloat* MakeLinearCurve()
+	{
+		UCurveFloat* Curve = NewObject<UCurveFloat>(GetTransientPackage());
+		Curve->FloatCurve.SetKeyInterpMode(Curve->FloatCurve.AddKey(0.0f, 0.0f), RCIM_Linear);
+		Curve->FloatCurve.SetKeyInterpMode(Curve->FloatCurve.AddKey(1.0f, 1.0f), RCIM_Linear);
+		return Curve;
+	}
+
+	/** Spawns a worker in EMayRecoilEvaluationMode::TimelineCurves with linear curves. */
+	static AMayRecoilWorker* SpawnTimelineWorker(UWorld* World)
+	{
+		AMayRecoilWorker* Worker = World->SpawnActorDeferred<AMayRecoilWorker>(AMayRecoilWorker::StaticClass(), FTransform::Identity);
+		Worker->EvaluationMode = EMayRecoilEvaluationMode::TimelineCurves;
+		Worker->AddRecoilCurve = MakeLinearCurve();
+		Worker->ResetRecoilCurve = MakeLinearCurve();
+
+		// BeginPlay binds the timelines to the curves
+		Worker->FinishSpawning(FTransform::Identity);
+		return Worker;
+	}
+
+	/**
+	 * Runs a script through a recoil component in a game world and returns the yaw and pitch applied to its controller.
+	 * In Actor mode the component uses a pooled worker, or a timeline worker if bTimelineCurves is set.
+	 */
+	static TArray<FVector2D> RunComponent(const FGoldenScript& Script, EMayRecoilWorkerMode WorkerMode, bool bTimelineCurves)
+	{
+		MayRecoilTest::FTestWorld TestWorld;
+		AMayRecoilWorker* Worker = bTimelineCurves ? SpawnTimelineWorker(TestWorld.GetWorld()) : nullptr;
+		UMaySimpleRecoilComponent* Component = TestWorld.SpawnRecoilCharacter(MakeScriptRecoilData(Script), WorkerMode, Seed, Worker);
+		TArray<FVector2D> Samples;
+
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			// Same order as FMayRecoilSimulation::Step: input and shot first, the world tick advances the recoil
+			if (IsShotFrame(Frame))
+			{
+				Component->Recoil();
+			}
+			else if (Frame > NumShots * FramesPerShot && Script.PlayerPitch != 0.0f)
+			{
+				Component->OnPitchAdded(Script.PlayerPitch);
+			}
+
+			TestWorld.Tick(DeltaTime);
+
+			if (IsSampleFrame(Frame))
+			{
+				Samples.Add(MayRecoilTest::FTestWorld::GetAppliedYawAndPitch(Component));
+			}
+		}
+		return Samples;
+	}
+
+	/**
+	 * Compares a trace against its golden trace. On a mismatch the current trace is logged in the format of the
+	 * golden traces above, so an intended change of the recoil can be recorded by replacing them.
+	 */
+	static void TestTrace(FAutomationTestBase& Test, const FString& What, const TArray<FVector2D>& Samples, TConstArrayView<FVector2D> Golden)
+	{
+		if (Golden.Num() != Samples.Num())
+		{
+			Test.AddError(FString::Printf(TEXT("%s: golden trace has %d samples, the script produced %d"), *What, Golden.Num(), Samples.Num()));
+			return;
+		}
+
+		int32 NumMismatches = 0;
+		for (int32 Index = 0; Index < Samples.Num(); ++Index)
+		{
+			if (!Samples[Index].Equals(Golden[Index], Tolerance))
+			{
+				++NumMismatches;
+				Test.AddError(FString::Printf(TEXT("%s at frame %d: expected (%f, %f), applied (%f, %f)"), *What,
+					Index * SampleInterval + SampleInterval - 1, Golden[Index].X, Golden[Index].Y, Samples[Index].X, Samples[Index].Y));
+			}
+		}
+
+		if (NumMismatches == 0) return;
+
+		FString Trace;
+		for (int32 Index = 0; Index < Samples.Num(); ++Index)
+		{
+			Trace += FString::Printf(TEXT("FVector2D(%f, %f),%s"), Samples[Index].X, Samples[Index].Y, Index % 4 == 3 ? TEXT("\n") : TEXT(" "));
+		}
+		Test.AddInfo(FString::Printf(TEXT("%s current trace:\n%s"), *What, *Trace));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMayRecoilGoldenTraceSimulationTest, "MayRecoil.GoldenTraces.Simulation",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/**
+ * FMayRecoilSimulation must apply the recorded recoil for every script.
+ */
+bool FMayRecoilGoldenTraceSimulationTest::RunTest(const FString& Parameters)
+{
+	using namespace MayRecoilGoldenTraceTest;
+
+	for (const FGoldenScript& Script : Scripts)
+	{
+		TestTrace(*this, FString::Printf(TEXT("%s simulation"), Script.Name), RunSimulation(Script), Script.Golden);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMayRecoilGoldenTraceSubsystemTest, "MayRecoil.GoldenTraces.SubsystemComponent",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/**
+ * A component in Subsystem mode must apply the recorded recoil to its controller.
+ */
+bool FMayRecoilGoldenTraceSubsystemTest::RunTest(const FString& Parameters)
+{
+	using namespace MayRecoilGoldenTraceTest;
+
+	const MayRecoilTest::FScopedFixedStepRate FixedStepRate(0.0f);
+	for (const FGoldenScript& Script : Scripts)
+	{
+		TestTrace(*this, FString::Printf(TEXT("%s subsystem"), Script.Name), RunComponent(Script, EMayRecoilWorkerMode::Subsystem, false), Script.Golden);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMayRecoilGoldenTraceWorkerTest, "MayRecoil.GoldenTraces.ActorWorker",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/**
+ * A component in Actor mode must apply the recorded recoil through the native playbacks of its worker
+ * and AMayRecoilWorker::FlushYawAndPitch.
+ */
+bool FMayRecoilGoldenTraceWorkerTest::RunTest(const FString& Parameters)
+{
+	using namespace MayRecoilGoldenTraceTest;
+
+	const MayRecoilTest::FScopedFixedStepRate FixedStepRate(0.0f);
+	for (const FGoldenScript& Script : Scripts)
+	{
+		TestTrace(*this, FString::Printf(TEXT("%s worker"), Script.Name), RunComponent(Script, EMayRecoilWorkerMode::Actor, false), Script.Golden);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMayRecoilGoldenTraceTimelineTest, "MayRecoil.GoldenTraces.TimelineWorker",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/**
+ * A worker in TimelineCurves mode with linear curves must apply the recorded recoil as well.
+ * Timelines restart the add phase on every shot, so the accumulating script is not covered.
+ */
+bool FMayRecoilGoldenTraceTimelineTest::RunTest(const FString& Parameters)
+{
+	using namespace MayRecoilGoldenTraceTest;
+
+	const MayRecoilTest::FScopedFixedStepRate FixedStepRate(0.0f);
+	for (const FGoldenScript& Script : Scripts)
+	{
+		if (Script.bAccumulateShots) continue;
+
+		TestTrace(*this, FString::Printf(TEXT("%s timeline worker"), Script.Name), RunComponent(Script, EMayRecoilWorkerMode::Actor, true), Script.Golden);
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
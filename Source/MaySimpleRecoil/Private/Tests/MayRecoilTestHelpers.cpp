@@ -0,0 +1,152 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Tests/MayRecoilTestHelpers.h"
+
+#if WITH_DEV_AUTOMATION_TESTS || MAYRECOIL_DEBUG
+
+#include "Core/Data/MayRecoilData.h"
+
+namespace MayRecoilTest
+{
+	UMayRecoilData* MakeRecoilData(bool bStaticPattern, bool bAccumulateShots)
+	{
+		UMayRecoilData* Data = NewObject<UMayRecoilData>(GetTransientPackage());
+		Data->RecoilInterpolation = EEasingFunc::EaseInOut;
+		Data->RecoilResetInterpolation = EEasingFunc::EaseOut;
+		Data->AccumulateShots = bAccumulateShots;
+		if (bAccumulateShots)
+		{
+			Data->RecoilSpeed = 6.0f;
+		}
+
+		Data->UseStaticPattern = bStaticPattern;
+		if (bStaticPattern)
+		{
+			Data->LoopStaticPattern = true;
+			for (int32 Index = 0; Index < 5; ++Index)
+			{
+				FStaticPatternData& Shot = Data->StaticPattern.AddDefaulted_GetRef();
+				Shot.Point = FVector2D((Index % 2 == 0 ? 0.2 : -0.3) * Index, 1.0 + 0.25 * Index);
+				Shot.MinRecoilVerticalStrength = -0.1f;
+				Shot.MaxRecoilVerticalStrength = 0.1f;
+				Shot.MinRecoilHorizontalStrength = -0.05f;
+				Shot.MaxRecoilHorizontalStrength = 0.05f;
+			}
+		}
+
+		Data->RebuildBakedData();
+		return Data;
+	}
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS || MAYRECOIL_DEBUG
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Core/Impl/MayRecoilWorker.h"
+#include "Core/Settings/MayRecoilSettings.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+
+namespace MayRecoilTest
+{
+	// ============================================================================
+	// Test World
+	// ============================================================================
+
+	FTestWorld::FTestWorld()
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("MayRecoilTestWorld"));
+
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+
+		// The game mode starts play, BeginPlay of the subsystem prewarms the worker pool
+		const FURL URL;
+		World->SetGameMode(URL);
+		World->InitializeActorsForPlay(URL);
+		World->BeginPlay();
+	}
+
+	FTestWorld::~FTestWorld()
+	{
+		if (!World) return; // World must be valid
+
+		// Ends play of the actors and the subsystem, the world takes all actors with it
+		World->EndPlay(EEndPlayReason::Quit);
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		World = nullptr;
+	}
+
+	void FTestWorld::Tick(float DeltaTime)
+	{
+		// The movement state snapshot of the components is built once per frame
+		++GFrameCounter;
+		World->Tick(LEVELTICK_All, DeltaTime);
+	}
+
+	UMaySimpleRecoilComponent* FTestWorld::SpawnRecoilCharacter(UMayRecoilData* Data, EMayRecoilWorkerMode WorkerMode, int32 Seed, AMayRecoilWorker* Worker)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParameters.ObjectFlags |= RF_Transient;
+
+		// Flying, so the character never falls and the recoil scale stays the same
+		ACharacter* Character = World->SpawnActor<ACharacter>(ACharacter::StaticClass(), FTransform::Identity, SpawnParameters);
+		Character->GetCharacterMovement()->DefaultLandMovementMode = MOVE_Flying;
+		Character->GetCharacterMovement()->SetMovementMode(MOVE_Flying);
+
+		UMaySimpleRecoilComponent* Component = NewObject<UMaySimpleRecoilComponent>(Character);
+		Component->WorkerMode = WorkerMode;
+		Component->RecoilData = Data;
+		Component->bApplyToControlRotation = true;
+		Component->SetRecoilSeed(Seed);
+		if (Worker)
+		{
+			// A bound worker is kept when the character is possessed
+			Component->RecoilWorkerInstance = Worker;
+			Worker->SetCurrentComponent(Component);
+		}
+		Character->AddInstanceComponent(Component);
+		Component->RegisterComponent();
+
+		// Possessing acquires the worker in Actor mode
+		APlayerController* Controller = World->SpawnActor<APlayerController>(APlayerController::StaticClass(), FTransform::Identity, SpawnParameters);
+		Controller->Possess(Character);
+		Controller->SetControlRotation(FRotator::ZeroRotator);
+
+		return Component;
+	}
+
+	FVector2D FTestWorld::GetAppliedYawAndPitch(const UMaySimpleRecoilComponent* Component)
+	{
+		const APawn* Pawn = Component ? Cast<APawn>(Component->GetOwner()) : nullptr;
+		const AController* Controller = Pawn ? Pawn->GetController() : nullptr;
+		if (!Controller) return FVector2D::ZeroVector; // Controller must be valid
+
+		// The component subtracts the recoil pitch from the control rotation
+		const FRotator Rotation = Controller->GetControlRotation().GetNormalized();
+		return FVector2D(Rotation.Yaw, -Rotation.Pitch);
+	}
+
+	// ============================================================================
+	// Settings
+	// ============================================================================
+
+	FScopedFixedStepRate::FScopedFixedStepRate(float StepRate)
+		: PreviousStepRate(GetDefault<UMayRecoilSettings>()->FixedStepRate)
+	{
+		GetMutableDefault<UMayRecoilSettings>()->FixedStepRate = StepRate;
+	}
+
+	FScopedFixedStepRate::~FScopedFixedStepRate()
+	{
+		GetMutableDefault<UMayRecoilSettings>()->FixedStepRate = PreviousStepRate;
+	}
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/Debug/MayRecoilDebug.h"
+#include "Misc/AutomationTest.h"
+
+class UMayRecoilData;
+
+#if WITH_DEV_AUTOMATION_TESTS || MAYRECOIL_DEBUG
+
+namespace MayRecoilTest
+{
+	/**
+	 * Creates transient recoil data with the easing, pattern and accumulation the tests run with.
+	 * Also built with MAYRECOIL_DEBUG, the simulation benchmark measures the same data.
+	 */
+	UMayRecoilData* MakeRecoilData(bool bStaticPattern, bool bAccumulateShots);
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS || MAYRECOIL_DEBUG
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Components/MaySimpleRecoilComponent.h"
+
+class UWorld;
+
+namespace MayRecoilTest
+{
+	/**
+	 * Game world for the duration of a test, runs without rendering (-nullrhi).
+	 * Tick advances the world time and runs the actor and subsystem ticks like a frame of the game.
+	 * All actors are destroyed together with the world when the test world goes out of scope.
+	 */
+	class FTestWorld
+	{
+	public:
+		FTestWorld();
+		~FTestWorld();
+
+		FTestWorld(const FTestWorld&) = delete;
+		FTestWorld& operator=(const FTestWorld&) = delete;
+
+		UWorld* GetWorld() const { return World; }
+
+		/** Advances the world by one frame. */
+		void Tick(float DeltaTime);
+
+		/**
+		 * Spawns a character possessed by a player controller, with a recoil component that applies the recoil
+		 * to the control rotation (see UMaySimpleRecoilComponent::bApplyToControlRotation).
+		 * In Actor mode the component uses the given worker instead of one from the pool.
+		 */
+		UMaySimpleRecoilComponent* SpawnRecoilCharacter(UMayRecoilData* Data, EMayRecoilWorkerMode WorkerMode, int32 Seed, AMayRecoilWorker* Worker = nullptr);
+
+		/** @return The recoil applied to the controller of the component, yaw (X) and pitch (Y) in recoil direction. */
+		static FVector2D GetAppliedYawAndPitch(const UMaySimpleRecoilComponent* Component);
+
+	private:
+		UWorld* World = nullptr;
+	};
+
+	/** Sets the fixed step rate of the project settings for its lifetime. */
+	struct FScopedFixedStepRate
+	{
+		explicit FScopedFixedStepRate(float StepRate);
+		~FScopedFixedStepRate();
+
+	private:
+		float PreviousStepRate;
+	};
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
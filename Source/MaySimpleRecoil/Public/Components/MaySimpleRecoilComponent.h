@@ -7,10 +7,76 @@
 #include "Core/Interface/MayRecoilDataProvider.h"
 #include "Core/Interface/MayRecoilStateInterface.h"
 #include "Core/Impl/MayRecoilWorker.h"
+#include "Core/Impl/MayRecoilWorkerObject.h"
+#include "Core/Net/MayRecoilNetTypes.h"
 #include "MaySimpleRecoilComponent.generated.h"
 
 class ACharacter;
+class UMayRecoilModifierData;
+class APawn;
+class AController;
 
+/**
+ * @brief Defines how the recoil of a component is simulated.
+ */
+UENUM(BlueprintType)
+enum class EMayRecoilWorkerMode : uint8
+{
+	/** Spawns one AMayRecoilWorker per component. Supports custom curves and Blueprint overrides of the worker. */
+	Actor,
+	/** Registers the component at the UMayRecoilSubsystem, which advances all recoil states in one batched tick. */
+	Subsystem,
+	/** Like Subsystem, but routes the recoil through a UMayRecoilWorkerObject with the same Blueprint hooks as AMayRecoilWorker. */
+	Object
+};
+
+/**
+ * @brief Recoil state of a recoil data that is currently not in use (see UMaySimpleRecoilComponent::SetRecoilData).
+ */
+USTRUCT()
+struct FMayRecoilCachedState
+{
+	GENERATED_BODY()
+
+	/** The recoil data the state belongs to. */
+	UPROPERTY()
+	UMayRecoilData* RecoilData = nullptr;
+
+	/** The state at the time it was cached. */
+	UPROPERTY()
+	FMayRecoilPackedState State;
+
+	/** World time the state was cached at, the state is decayed by the time since then when it is used again. */
+	float CachedTime = 0.0f;
+
+	/** Server side pattern index and time of the last shot of this recoil data. */
+	int32 ServerPatternIndex = 0;
+	float ServerLastShotTime = -UE_BIG_NUMBER;
+};
+
+/**
+ * @brief Attachment modifiers of one recoil data and the recoil data compiled from them.
+ */
+USTRUCT(BlueprintType)
+struct FMayRecoilModifierStack
+{
+	GENERATED_BODY()
+
+	/** The recoil data (weapon) the modifiers are attached to. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MaySimpleRecoil")
+	UMayRecoilData* RecoilData = nullptr;
+
+	/** Attachment modifiers applied to RecoilData, see UMayRecoilModifierData::CompileRecoilData. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MaySimpleRecoil")
+	TArray<UMayRecoilModifierData*> Modifiers;
+
+	/** RecoilData with all Modifiers applied, valid while bCompiledValid is set. */
+	UPROPERTY(Transient)
+	UMayRecoilData* CompiledRecoilData = nullptr;
+	bool bCompiledValid = false;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FMayRecoilValidationFailedSignature, int32, ShotIndex, FVector2D, Error);
 
 UCLASS(ClassGroup=(MayRecoil), meta=(BlueprintSpawnableComponent), Blueprintable, HideCategories=(Object, LOD, Physics, Lighting, TextureStreaming, Collision, HLOD, Mobile, VirtualTexture, ComponentReplication))
 class MAYSIMPLERECOIL_API UMaySimpleRecoilComponent : public UActorComponent, public IMayRecoilStateInterface, public IMayRecoilDataProvider
@@ -19,12 +85,19 @@ class MAYSIMPLERECOIL_API UMaySimpleRecoilComponent : public UActorComponent, pu
 
 public:
 	UMaySimpleRecoilComponent();
+
+	/** Acquires a worker from the worker pool of the UMayRecoilSubsystem if the component has none. */
 	void TrySpawnRecoilWorkerInstance();
 
+	/** Returns the worker to the worker pool of the UMayRecoilSubsystem. */
+	void ReleaseRecoilWorkerInstance();
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void InitializeComponent() override;
 public:
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	
 	UFUNCTION(BlueprintCallable, Category = "MaySimpleRecoil")
 	void Recoil();
@@ -39,6 +112,9 @@ public:
 	void UpdatePlayerYawAndPitch(float Yaw, float Pitch);
 	virtual void UpdatePlayerYawAndPitch_Implementation(float Yaw, float Pitch);
 
+	/** Applies the recoil of a frame. Skips the Blueprint event thunk if UpdatePlayerYawAndPitch is not overridden in Blueprint. */
+	void ApplyRecoilYawAndPitch(float Yaw, float Pitch);
+
 	// ============================== Recoil State ==============================
 	
 	UPROPERTY(BlueprintReadOnly, Category = "Recoil|State")
@@ -46,12 +122,82 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "Recoil|State")
 	void TrySetADS(bool bNewADS);
+
+	/**
+	 * Returns the movement state snapshot of the owner. The snapshot is built at most once per frame,
+	 * all state queries and the recoil scale read from it.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Recoil|State", meta = (ReturnDisplayName = "MovementState"))
+	EMayRecoilMovementState GetMovementState() const;
+
+	/** Discards the movement state snapshot, call this when the state changed in the middle of a frame (e.g. from a movement mode change). */
+	UFUNCTION(BlueprintCallable, Category = "Recoil|State")
+	void InvalidateMovementState();
+
+	/** Activates or deactivates project specific states (Custom1..Custom3, see UMayRecoilSettings::CustomStates). */
+	UFUNCTION(BlueprintCallable, Category = "Recoil|State")
+	void SetCustomMovementState(EMayRecoilMovementState State, bool bActive);
 	
 	// ============================== Recoil Strength ==============================
 
 	UPROPERTY(EditAnywhere, Category = "MaySimpleRecoil")
 	bool bEnableRecoil = true;
 
+	/**
+	 * Writes the recoil directly to the control rotation of the controller instead of using AddControllerYawInput / AddControllerPitchInput.
+	 * Yaw and pitch are applied as degrees, without input scaling or sensitivity, and work for any controller.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil")
+	bool bApplyToControlRotation = false;
+
+	// ============================== Recoil Random ==============================
+
+	/** Seed of the deterministic recoil random stream. Chosen by the server and replicated, so all machines generate the same recoil. */
+	UPROPERTY(Replicated, BlueprintReadOnly, Category = "MaySimpleRecoil|Random")
+	int32 RecoilSeed = 0;
+
+	/** Sets the seed of the recoil random stream. Only has an effect on the server. */
+	UFUNCTION(BlueprintCallable, Category = "MaySimpleRecoil|Random")
+	void SetRecoilSeed(int32 NewSeed);
+
+	/** Returns the current recoil state quantized to a few bytes, e.g. for a save game or a rollback snapshot. */
+	UFUNCTION(BlueprintCallable, Category = "MaySimpleRecoil")
+	FMayRecoilPackedState GetPackedRecoilState() const;
+
+	/** Restores a recoil state returned by GetPackedRecoilState. The rotation of the player is not changed. */
+	UFUNCTION(BlueprintCallable, Category = "MaySimpleRecoil")
+	void SetPackedRecoilState(const FMayRecoilPackedState& PackedState);
+
+	// ============================== Recoil Network ==============================
+
+	/**
+	 * The owning client predicts the recoil and sends the shots of each frame compactly and unreliably to the server. The server
+	 * recomputes the shots from the shared seed without worker or timeline and only answers with a correction if the recoil does not match.
+	 * Shots have to be fired on the owning client, combine OnRecoilValidationFailed with your own fire validation for anti-cheat.
+	 * Both sides scale the shots with CalculateRecoilScale, overrides of GetRecoilScale in the worker are ignored in this mode.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MaySimpleRecoil|Network")
+	bool bServerAuthoritativeRecoil = false;
+
+	/** Maximum difference in degrees between the predicted and the server recoil of a shot before a correction is sent. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MaySimpleRecoil|Network", meta = (EditCondition = "bServerAuthoritativeRecoil", ClampMin = "0.01"))
+	float NetRecoilTolerance = 0.02f;
+
+	/** Time in seconds around the end of a spray in which the server accepts the pattern index of the client. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MaySimpleRecoil|Network", meta = (EditCondition = "bServerAuthoritativeRecoil", ClampMin = "0"))
+	float NetSprayResetTolerance = 0.1f;
+
+	/**
+	 * Highest fire rate in shots per second the server expects from the client. Shots whose index skips more shots than could
+	 * have been fired at this rate since the last validated shot are rejected, so a forged index cannot stop the validation.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MaySimpleRecoil|Network", meta = (EditCondition = "bServerAuthoritativeRecoil", ClampMin = "1"))
+	float NetMaxFireRate = 30.0f;
+
+	/** Called on the server if the recoil of a client shot did not match and a correction was sent. */
+	UPROPERTY(BlueprintAssignable, Category = "MaySimpleRecoil|Network")
+	FMayRecoilValidationFailedSignature OnRecoilValidationFailed;
+
 	// ============================== Recoil Animation ==============================
 	
 	/** Interner Zeiger auf den ACharacter, dessen Zustand abgefragt wird */
@@ -61,12 +207,72 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "MaySimpleRecoil|State")
 	float SprintSpeedThreshold = 600.0f;
 
+	/** How the recoil of this component is simulated. */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MaySimpleRecoil")
+	EMayRecoilWorkerMode WorkerMode = EMayRecoilWorkerMode::Actor;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MaySimpleRecoil", meta = (EditCondition = "WorkerMode == EMayRecoilWorkerMode::Actor"))
 	TSubclassOf<AMayRecoilWorker> RecoilWorker;
 
+	/** Worker class created in EMayRecoilWorkerMode::Object, UMayRecoilWorkerObject if not set. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MaySimpleRecoil", meta = (EditCondition = "WorkerMode == EMayRecoilWorkerMode::Object"))
+	TSubclassOf<UMayRecoilWorkerObject> RecoilWorkerObjectClass;
+
+	/** Recoil data of the component itself, used while no IMayRecoilDataProvider of the owner provides one (see ProvideRecoilData). */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MaySimpleRecoil")
 	UMayRecoilData* RecoilData = nullptr;
 
+	/**
+	 * Sets the recoil data of the component itself and switches to it, e.g. on a weapon swap without provider.
+	 * The state of the previous data (pattern index, reset progress) is cached and restored when the data is used again,
+	 * decayed by the time it was not in use. Call this on the server as well when using bServerAuthoritativeRecoil.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MaySimpleRecoil")
+	void SetRecoilData(UMayRecoilData* NewRecoilData);
+
+	/** Returns the recoil data currently in use, the provided one or RecoilData, without modifiers applied. */
+	UFUNCTION(BlueprintPure, Category = "MaySimpleRecoil")
+	UMayRecoilData* GetActiveRecoilData() const { return ActiveRecoilData; }
+
+	/**
+	 * Attachment modifiers of each recoil data. The modifiers of a weapon stay with its recoil data,
+	 * a weapon swap neither carries them to another weapon nor recompiles them.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MaySimpleRecoil")
+	TArray<FMayRecoilModifierStack> RecoilModifierStacks;
+
+	/** Attaches a modifier to ForRecoilData, the active recoil data if not set. */
+	UFUNCTION(BlueprintCallable, Category = "MaySimpleRecoil")
+	void AddRecoilModifier(UMayRecoilModifierData* Modifier, UMayRecoilData* ForRecoilData = nullptr);
+
+	/** Removes a modifier from ForRecoilData, the active recoil data if not set. */
+	UFUNCTION(BlueprintCallable, Category = "MaySimpleRecoil")
+	void RemoveRecoilModifier(UMayRecoilModifierData* Modifier, UMayRecoilData* ForRecoilData = nullptr);
+
+	/** Removes all modifiers from ForRecoilData, the active recoil data if not set. */
+	UFUNCTION(BlueprintCallable, Category = "MaySimpleRecoil")
+	void ClearRecoilModifiers(UMayRecoilData* ForRecoilData = nullptr);
+
+	/** Returns the modifiers attached to ForRecoilData, the active recoil data if not set. */
+	UFUNCTION(BlueprintPure, Category = "MaySimpleRecoil")
+	TArray<UMayRecoilModifierData*> GetRecoilModifiers(UMayRecoilData* ForRecoilData = nullptr) const;
+
+	/** Recompiles the effective recoil data of all stacks on the next shot. Call this after editing the modifiers of an attached UMayRecoilModifierData. */
+	UFUNCTION(BlueprintCallable, Category = "MaySimpleRecoil")
+	void InvalidateRecoilModifiers();
+
+	/** Returns the active recoil data with its modifiers applied, compiled only when its modifier stack changed. */
+	UFUNCTION(BlueprintCallable, Category = "MaySimpleRecoil")
+	UMayRecoilData* GetEffectiveRecoilData();
+
+	/** Number of recoil data states kept by SetRecoilData, the least recently used one is dropped first. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MaySimpleRecoil", meta = (ClampMin = "0"))
+	int32 MaxCachedRecoilStates = 4;
+
+	/** Worker of EMayRecoilWorkerMode::Object. */
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "MaySimpleRecoil")
+	UMayRecoilWorkerObject* RecoilWorkerObject = nullptr;
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MaySimpleRecoil")
 	AMayRecoilWorker* RecoilWorkerInstance = nullptr;
 
@@ -77,5 +283,117 @@ public:
 	virtual bool CanSwitchToADS_Implementation() const override;
 	virtual bool IsADS_Implementation() const override;
 	
+	/**
+	 * Searches the owner, its components and its attached actors (recursively) for another IMayRecoilDataProvider,
+	 * falls back to RecoilData. Only called when the cached result has been invalidated.
+	 */
 	virtual UMayRecoilData* ProvideRecoilData_Implementation() const override;
+
+	/**
+	 * Discards the cached result of ProvideRecoilData, the next shot searches again.
+	 * Call this after equipping a weapon or changing its attachments.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MaySimpleRecoil")
+	void InvalidateRecoilData();
+
+	/** Returns the cached result of ProvideRecoilData, searching only if it has been invalidated. */
+	UFUNCTION(BlueprintCallable, Category = "MaySimpleRecoil")
+	UMayRecoilData* GetProvidedRecoilData();
+
+	// ============================== Recoil Calculation ==============================
+
+	/** Calculates the recoil scale factor of the given data based on the current movement state (a lookup into the baked scale table). */
+	float CalculateRecoilScale(const UMayRecoilData* Data) const;
+
+	/**
+	 * Calculates the yaw and pitch strength of a single shot of the given data, scaled by Scale and drawn from Stream.
+	 * PatternShotIndex is the number of shots since the last reset and selects the static pattern entry, if the data uses one.
+	 */
+	void CalculateRecoilYawAndPitchStrength(const UMayRecoilData* Data, float Scale, FRandomStream& Stream, int32 PatternShotIndex, float& OutYaw, float& OutPitch) const;
+
+	/**
+	 * Generates the next shot of the given random stream. On a predicting client with bServerAuthoritativeRecoil
+	 * the shot is also sent to the server for validation, and Scale is replaced by CalculateRecoilScale so it matches the server.
+	 */
+	void GenerateShot(const UMayRecoilData* Data, float Scale, FMayRecoilRandom& Random, int32 PatternShotIndex, float& OutYaw, float& OutPitch);
+
+protected:
+	/** Validates the shots predicted by the owning client during one frame. Lost shots are skipped by their shot index. */
+	UFUNCTION(Server, Unreliable)
+	void ServerRecoilShots(const TArray<FMayRecoilNetShot>& Shots);
+
+	/** Corrects the predicted recoil of the owning client. */
+	UFUNCTION(Client, Reliable)
+	void ClientRecoilCorrection(const FMayRecoilNetCorrection& Correction);
+
+private:
+	friend class UMayRecoilSubsystem;
+
+	/** Acquires the worker when the owning pawn is possessed and releases it when it is unpossessed. */
+	UFUNCTION()
+	void OnOwnerControllerChanged(APawn* Pawn, AController* OldController, AController* NewController);
+
+	/** Validates a single shot of ServerRecoilShots. */
+	void ValidateRecoilShot(const FMayRecoilNetShot& Shot);
+
+	/** Sends the shots queued by GenerateShot in a single ServerRecoilShots. */
+	void FlushNetShots();
+
+	/** Shots predicted this frame, sent with the next FlushNetShots. */
+	TArray<FMayRecoilNetShot> PendingNetShots;
+
+	/** Index of the recoil state in the UMayRecoilSubsystem, INDEX_NONE if not registered. */
+	int32 RecoilStateIndex = INDEX_NONE;
+
+	/** Whether UpdatePlayerYawAndPitch is overridden in Blueprint, cached on BeginPlay. */
+	bool bUpdatePlayerYawAndPitchInScript = false;
+
+	/** The recoil data the current state belongs to. */
+	UPROPERTY(Transient)
+	UMayRecoilData* ActiveRecoilData = nullptr;
+
+	/** States of the recoil data not in use, see SetRecoilData. */
+	UPROPERTY(Transient)
+	TArray<FMayRecoilCachedState> CachedRecoilStates;
+
+	/** Cached result of ProvideRecoilData, valid while bProvidedRecoilDataValid is set. */
+	UPROPERTY(Transient)
+	UMayRecoilData* ProvidedRecoilData = nullptr;
+	bool bProvidedRecoilDataValid = false;
+
+	/** Returns the modifier stack of ForRecoilData (the active recoil data if not set), nullptr if it has none. */
+	FMayRecoilModifierStack* FindRecoilModifierStack(const UMayRecoilData* ForRecoilData);
+	const FMayRecoilModifierStack* FindRecoilModifierStack(const UMayRecoilData* ForRecoilData) const;
+
+	/** Value of RecoilData the provider cache was built with, a different value invalidates it. */
+	UPROPERTY(Transient)
+	UMayRecoilData* ConfiguredRecoilData = nullptr;
+
+	/** Switches to the provided recoil data if it changed and returns the effective recoil data. */
+	UMayRecoilData* UpdateRecoilData();
+
+	/** Caches the state of the active recoil data and restores the state of the new one. Does not change RecoilData. */
+	void SwitchRecoilData(UMayRecoilData* NewRecoilData);
+
+	/** Recursive search of ProvideRecoilData_Implementation. */
+	static UMayRecoilData* DefaultFindRecoilData(const AActor* Actor);
+
+protected:
+	/** Queries the owner once and builds the movement state bitmask. Override to add custom state sources. */
+	virtual EMayRecoilMovementState BuildMovementState() const;
+
+private:
+	/** Movement state snapshot of the frame MovementStateFrame. */
+	mutable EMayRecoilMovementState MovementState = EMayRecoilMovementState::None;
+
+	/** Server side recoil of the owning client: random stream, pattern index of the next shot and time of the last shot. */
+	FMayRecoilRandom ServerRandom;
+	int32 ServerPatternIndex = 0;
+	float ServerLastShotTime = -UE_BIG_NUMBER;
+
+	/** Custom states set with SetCustomMovementState. */
+	EMayRecoilMovementState CustomMovementState = EMayRecoilMovementState::None;
+
+	/** Frame (GFrameCounter) the movement state snapshot was built in. */
+	mutable uint64 MovementStateFrame = MAX_uint64;
 };
\ No newline at end of file
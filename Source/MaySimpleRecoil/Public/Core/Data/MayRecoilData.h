@@ -3,8 +3,14 @@
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Core/Impl/MayRecoilEvaluator.h"
+#include "Core/Interface/MayRecoilStateInterface.h"
 #include "MayRecoilData.generated.h"
 
+/**
+ * Ein Schuss eines statischen Recoil-Patterns.
+ * Point ist der Recoil des Schusses (X = horizontal, Y = vertikal), die Min/Max-Werte sind ein zusätzlicher Jitter.
+ */
 USTRUCT(BlueprintType)
 struct FStaticPatternData
 {
@@ -26,6 +32,71 @@ struct FStaticPatternData
 	float MaxRecoilHorizontalStrength = 0.0f;
 };
 
+/**
+ * @brief Static pattern baked into a packed structure-of-arrays layout.
+ *
+ * The per-shot lookup reads one entry of each array instead of walking the UPROPERTY structs.
+ */
+struct MAYSIMPLERECOIL_API FMayRecoilPatternTable
+{
+	/** Horizontal (X) and vertical (Y) recoil of each shot. */
+	TArray<FVector2f> Points;
+
+	/** Jitter of each shot: min horizontal, max horizontal, min vertical, max vertical. */
+	TArray<FVector4f> Jitter;
+
+	/** Bakes the table from the editable pattern. */
+	void Bake(const TArray<FStaticPatternData>& Pattern);
+
+	FORCEINLINE int32 Num() const { return Points.Num(); }
+};
+
+/**
+ * @brief Recoil scale of every combination of scaling movement states, indexed by the EMayRecoilMovementState bitmask.
+ *
+ * Holds 2^N entries for the four built-in states plus the configured custom states, so the scale of a shot
+ * is a single lookup instead of one branch per state.
+ */
+struct MAYSIMPLERECOIL_API FMayRecoilScaleTable
+{
+	/** Scale of each state combination. */
+	TArray<float> Multipliers;
+
+	/**
+	 * @brief Bakes the table.
+	 * @param BaseScale Scale without any active state.
+	 * @param StateScales Scale of each state bit, starting with EMayRecoilMovementState::Crouch.
+	 */
+	void Bake(float BaseScale, TConstArrayView<float> StateScales);
+
+	/** @return The scale for the given movement state, state bits outside of the table are ignored. */
+	FORCEINLINE float Lookup(EMayRecoilMovementState State) const
+	{
+		return Multipliers.Num() > 0 ? Multipliers[static_cast<uint8>(State) & (Multipliers.Num() - 1)] : 1.0f;
+	}
+};
+
+/**
+ * @brief Custom version of UMayRecoilData, used to migrate assets saved with an older plugin version.
+ */
+struct MAYSIMPLERECOIL_API FMayRecoilDataCustomVersion
+{
+	enum Type
+	{
+		/** Before the custom version was introduced. */
+		BeforeCustomVersionWasAdded = 0,
+		/** The asset scales are only used with OverrideScaleSettings, the project settings otherwise. */
+		ScaleSettingsOverride,
+
+		// -----<new versions can be added above this line>-------------------------------------------------
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	/** The GUID of this custom version. */
+	static const FGuid GUID;
+};
+
 /**
  * DataAsset für das Recoil-System
  */
@@ -57,33 +128,42 @@ public:
 	bool ForceMinMaxHorizontalStrength = false;
 
 	// ============================== Recoil Pattern ==============================
-	// TODO: Implement Recoil Pattern
-	// UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil|Pattern|Static")
-	// bool UseStaticPattern = false;
-	//
-	// UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil|Pattern|Static")
-	// TArray<FStaticPatternData> StaticPattern;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil|Pattern|Static")
+	bool UseStaticPattern = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil|Pattern|Static", meta = (EditCondition = "UseStaticPattern"))
+	TArray<FStaticPatternData> StaticPattern;
+
+	/** Startet nach dem letzten Schuss wieder beim ersten, sonst wird der letzte Schuss wiederholt */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil|Pattern|Static", meta = (EditCondition = "UseStaticPattern"))
+	bool LoopStaticPattern = false;
 	
 	// ============================== Recoil Scale ==============================
 
+	/** Verwendet die Scale-Werte dieses Assets statt der Projekteinstellungen (UMayRecoilSettings) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil|Scale")
 	bool OverrideScaleSettings = false;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil|Scale")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil|Scale", meta = (EditCondition = "OverrideScaleSettings"))
 	float RecoilScale = 1.0f;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil|Scale")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil|Scale", meta = (EditCondition = "OverrideScaleSettings"))
 	float RecoilScaleSprint = 2.0f;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil|Scale")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil|Scale", meta = (EditCondition = "OverrideScaleSettings"))
 	float RecoilScaleCrouch = 0.25f;
 	
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil|Scale")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil|Scale", meta = (EditCondition = "OverrideScaleSettings"))
 	float RecoilScaleJump = 1.0f;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil|Scale")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil|Scale", meta = (EditCondition = "OverrideScaleSettings"))
 	float RecoilScaleADS = 1.0f;
 
+	/** Scale der eigenen Zustände, in der Reihenfolge der Projekteinstellungen (Custom1..Custom3) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil|Scale", meta = (EditCondition = "OverrideScaleSettings"))
+	TArray<float> RecoilScaleCustom;
+
 	// ============================== Recoil Animation ==============================
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil|Animation")
@@ -92,6 +172,13 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil|Animation")
 	float RecoilSpeed = 3.0f;
 
+	/**
+	 * Schüsse starten die Recoil-Animation nicht neu, sondern werden überlagert. Mehrere Schüsse im selben Frame
+	 * werden gemeinsam berechnet (für hohe Feuerraten). Nur im Analytic-Modus des Workers und im Subsystem-Modus.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil|Animation")
+	bool AccumulateShots = false;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil|Animation")
 	TEnumAsByte<EEasingFunc::Type> RecoilInterpolation = EEasingFunc::Linear;
 
@@ -134,4 +221,38 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil|Preview")
 	int32 BulletRadius = 2;
+
+	// ============================== Baked Data ==============================
+
+	/** Bakes the easing tables, the static pattern and the scale table from the current settings. Call after changing them at runtime. */
+	UFUNCTION(BlueprintCallable, Category = "MaySimpleRecoil")
+	void RebuildBakedData();
+
+	/**
+	 * Returns the index into PatternTable for the given shot, INDEX_NONE if no static pattern is used.
+	 * @param ShotIndex Number of shots since the last reset.
+	 */
+	int32 GetPatternTableIndex(int32 ShotIndex) const;
+
+	/** @return The recoil scale for the given movement state. */
+	FORCEINLINE float GetStateScale(EMayRecoilMovementState State) const { return ScaleTable.Lookup(State); }
+
+	/** Baked easing of RecoilInterpolation */
+	FMayRecoilEasingTable AddEasingTable;
+
+	/** Baked easing of RecoilResetInterpolation */
+	FMayRecoilEasingTable ResetEasingTable;
+
+	/** Baked StaticPattern */
+	FMayRecoilPatternTable PatternTable;
+
+	/** Baked scale settings of this asset or the project */
+	FMayRecoilScaleTable ScaleTable;
+
+	virtual void PostInitProperties() override;
+	virtual void Serialize(FArchive& Ar) override;
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 };
\ No newline at end of file
@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Copyright (c) 2023 MayStudios (Sven Maibaum).
+ * All Rights Reserved.
+ *
+ * This software and its accompanying documentation are the exclusive property
+ * of MayStudios (Sven Maibaum). No part of this software may be reproduced,
+ * distributed, modified, or transmitted in any form or by any means, including
+ * without limitation electronic, mechanical, or otherwise, without the prior
+ * written permission of the owner.
+ *
+ * This software is licensed for sale exclusively on fab. Unauthorized use,
+ * copying, or distribution is strictly prohibited.
+ *
+ * For licensing inquiries or further information, please contact:
+ * [Insert your contact information or website URL here].
+ *
+ * Author: Sven Maibaum
+ * Project: MayStudios
+*****************************************************************************/
+
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "MayRecoilModifierData.generated.h"
+
+class UMayRecoilData;
+
+/**
+ * @brief Value of UMayRecoilData changed by a recoil modifier.
+ */
+UENUM(BlueprintType)
+enum class EMayRecoilModifierField : uint8
+{
+	/** Min and max vertical strength and the vertical recoil of the static pattern. Add changes the magnitude, a zero strength counts as positive. */
+	VerticalStrength,
+	/** Min and max horizontal strength and the horizontal recoil of the static pattern. Add changes the magnitude, a zero strength counts as positive. */
+	HorizontalStrength,
+	/** RecoilScale, the scale in every movement state. */
+	Scale,
+	/** RecoilSpeed. */
+	RecoilSpeed,
+	/** RecoilResetDelay. */
+	ResetDelay,
+	/** RecoilResetSpeed. */
+	ResetSpeed,
+	/** RecoilScaleSprint. */
+	ScaleSprint,
+	/** RecoilScaleCrouch. */
+	ScaleCrouch,
+	/** RecoilScaleJump. */
+	ScaleJump,
+	/** RecoilScaleADS. */
+	ScaleADS,
+
+	Num UMETA(Hidden)
+};
+
+/**
+ * @brief How a recoil modifier is combined with the value.
+ */
+UENUM(BlueprintType)
+enum class EMayRecoilModifierOp : uint8
+{
+	/** Added to the value before any multiplier. */
+	Add,
+	/** Multiplies the value after all additions. */
+	Multiply
+};
+
+/**
+ * @brief A single modifier of an attachment.
+ */
+USTRUCT(BlueprintType)
+struct FMayRecoilModifier
+{
+	GENERATED_BODY()
+
+	/** The value of UMayRecoilData that is changed. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Recoil")
+	EMayRecoilModifierField Field = EMayRecoilModifierField::VerticalStrength;
+
+	/** How Value is combined with the field. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Recoil")
+	EMayRecoilModifierOp Op = EMayRecoilModifierOp::Multiply;
+
+	/** Amount added to or factor multiplied with the field. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Recoil")
+	float Value = 1.0f;
+};
+
+/**
+ * @brief Data asset of an attachment (muzzle brake, grip, stock, ...) that changes the recoil of a weapon.
+ */
+UCLASS(BlueprintType)
+class MAYSIMPLERECOIL_API UMayRecoilModifierData : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Modifiers of this attachment. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaySimpleRecoil")
+	TArray<FMayRecoilModifier> Modifiers;
+
+	/**
+	 * @brief Compiles recoil data and a modifier stack into a flattened recoil data.
+	 *
+	 * Each field becomes (Value + sum of all Add modifiers) * product of all Multiply modifiers, independent of
+	 * the order of the stack. Strengths are signed, Add changes their magnitude so a spread keeps its center, zero counts as positive.
+	 * Scale modifiers of data without OverrideScaleSettings start from the project settings and set the override.
+	 * The result is a transient copy with rebuilt baked data, so the per-shot path reads it like any other recoil data.
+	 * @param BaseData The unmodified recoil data.
+	 * @param ModifierData The modifier stack, null entries are ignored.
+	 * @param Outer The outer of the compiled recoil data.
+	 * @return The compiled recoil data, nullptr if BaseData is not valid.
+	 */
+	static UMayRecoilData* CompileRecoilData(const UMayRecoilData* BaseData, TConstArrayView<UMayRecoilModifierData*> ModifierData, UObject* Outer);
+};
@@ -0,0 +1,281 @@
+/******************************************************************************
+ * Copyright (c) 2023 MayStudios (Sven Maibaum).
+ * All Rights Reserved.
+ *
+ * This software and its accompanying documentation are the exclusive property
+ * of MayStudios (Sven Maibaum). No part of this software may be reproduced,
+ * distributed, modified, or transmitted in any form or by any means, including
+ * without limitation electronic, mechanical, or otherwise, without the prior
+ * written permission of the owner.
+ *
+ * This software is licensed for sale exclusively on fab. Unauthorized use,
+ * copying, or distribution is strictly prohibited.
+ *
+ * For licensing inquiries or further information, please contact:
+ * [Insert your contact information or website URL here].
+ *
+ * Author: Sven Maibaum
+ * Project: MayStudios
+*****************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "Core/Impl/MayRecoilEvaluator.h"
+#include "Core/Net/MayRecoilNetTypes.h"
+#include "MayRecoilState.generated.h"
+
+class UMayRecoilData;
+
+/**
+ * @brief Phase of a recoil state.
+ */
+UENUM(BlueprintType)
+enum class EMayRecoilPhase : uint8
+{
+	/** No recoil is being applied or reset. */
+	Idle,
+	/** The recoil of the last shot is being applied. */
+	Adding,
+	/** The recoil has been applied and the reset delay is counting down. */
+	WaitingForReset,
+	/** The accumulated recoil is being reset. */
+	Resetting
+};
+
+/**
+ * @brief Deterministic random stream of a recoil state.
+ *
+ * The stream is reseeded for every shot from a replicated seed and the shot index, so the
+ * recoil of a shot only depends on these two values. Server, client and replays generate
+ * the same recoil, and no global RNG state is touched.
+ */
+USTRUCT(BlueprintType)
+struct MAYSIMPLERECOIL_API FMayRecoilRandom
+{
+	GENERATED_BODY()
+
+	/**
+	 * @brief Reseeds the stream for the next shot and advances the shot index.
+	 * @param InSeed The seed of the owning component.
+	 * @return The stream seeded for this shot.
+	 */
+	FRandomStream& NextShot(int32 InSeed);
+
+	/**
+	 * @brief Continues the stream and the static pattern after a server correction.
+	 *
+	 * The shot index never moves backwards: shots fired after the corrected one keep their indices and the
+	 * pattern index is rebased by them, a rewound index would repeat shots the server has already validated.
+	 * @param NextShotIndex The shot index the server continues with.
+	 * @param NextPatternIndex The pattern index the server continues with.
+	 * @param InOutPatternIndex The pattern index of the next shot of the client.
+	 */
+	void ApplyCorrection(int32 NextShotIndex, int32 NextPatternIndex, int32& InOutPatternIndex);
+
+	/** Seed used for the last shot. */
+	UPROPERTY(BlueprintReadOnly, Category = "MayRecoil")
+	int32 Seed = 0;
+
+	/** Index of the next shot. */
+	UPROPERTY(BlueprintReadOnly, Category = "MayRecoil")
+	int32 ShotIndex = 0;
+
+	/** Stream seeded for the current shot. */
+	FRandomStream Stream;
+};
+
+/**
+ * @brief Plain recoil state of a single character.
+ *
+ * Holds the same values AMayRecoilWorker keeps in its timelines and temporary runtime variables,
+ * but without an actor or timeline behind it. This allows many states to be stored contiguously
+ * and advanced in one batch (see UMayRecoilSubsystem).
+ *
+ * Both phases progress from 0 to 1 scaled by RecoilSpeed / RecoilResetSpeed, which matches the
+ * default linear 0..1 curves of the worker timelines.
+ */
+USTRUCT(BlueprintType)
+struct MAYSIMPLERECOIL_API FMayRecoilState
+{
+	GENERATED_BODY()
+
+	// ================================================================
+	// Simulation
+	// ================================================================
+
+	/**
+	 * @brief Starts applying the recoil of a new shot.
+	 * @param InRecoilData The recoil data used for this shot.
+	 * @param Yaw The yaw strength of the shot.
+	 * @param Pitch The pitch strength of the shot.
+	 */
+	void Fire(UMayRecoilData* InRecoilData, float Yaw, float Pitch);
+
+	/**
+	 * @brief Advances the state by the given time.
+	 * @param DeltaTime The time to advance.
+	 * @return The yaw (X) and pitch (Y) that have to be applied to the player this step.
+	 */
+	FVector2D Advance(float DeltaTime);
+
+	/**
+	 * @brief Advances the progress of the add or reset phase without easing it, the first half of Advance.
+	 *
+	 * Lets the owner ease the alphas of many states together (see FMayRecoilEaseBatch) and finish each step with
+	 * FinishEasedStep. The other phases return false and are advanced with Advance.
+	 * @param DeltaTime The time to advance.
+	 * @param OutEasing Receives the easing of the phase, Alpha holds the linear alpha to ease.
+	 * @return Whether the step has to be finished with FinishEasedStep.
+	 */
+	bool BeginEasedStep(float DeltaTime, FMayRecoilEasing& OutEasing);
+
+	/**
+	 * @brief Applies the eased alpha of the step started with BeginEasedStep, the second half of Advance.
+	 * @param EasedAlpha The alpha eased with the easing returned by BeginEasedStep.
+	 * @return The yaw (X) and pitch (Y) that have to be applied to the player this step.
+	 */
+	FVector2D FinishEasedStep(float EasedAlpha);
+
+	/**
+	 * @brief Advances the state in fixed steps up to the given time.
+	 * @param Time The current world time.
+	 * @param StepRate Steps per second.
+	 * @param MaxSteps Maximum number of steps, the rest is dropped.
+	 * @return The summed yaw (X) and pitch (Y) of all steps.
+	 */
+	FVector2D AdvanceFixed(double Time, float StepRate, int32 MaxSteps);
+
+	/**
+	 * @brief Starts resetting the accumulated recoil if reset is enabled.
+	 */
+	void BeginReset();
+
+	/**
+	 * @brief Immediately clears the state.
+	 */
+	void Clear();
+
+	/**
+	 * @brief Advances the state by a longer time without applying anything, e.g. for a state that was not in use.
+	 *
+	 * Steps phase by phase until the state is idle or the time is used up, so the cost does not depend on the elapsed time.
+	 * @param Time The elapsed time.
+	 */
+	void Decay(float Time);
+
+	/** @return The time until the current phase ends. */
+	float GetPhaseTimeRemaining() const;
+
+	/**
+	 * @brief Handles yaw input added by the player.
+	 * @param Yaw The yaw value added by the player.
+	 * @param DeltaTime The current frame time.
+	 */
+	void AddPlayerYaw(float Yaw, float DeltaTime);
+
+	/**
+	 * @brief Handles pitch input added by the player.
+	 * @param Pitch The pitch value added by the player.
+	 */
+	void AddPlayerPitch(float Pitch);
+
+	/**
+	 * @brief Applies a server correction (see UMaySimpleRecoilComponent::bServerAuthoritativeRecoil).
+	 * @param NextShotIndex The shot index to continue with.
+	 * @param NextPatternIndex The pattern index to continue with.
+	 * @param Delta The yaw (X) and pitch (Y) added to match the server.
+	 */
+	void ApplyCorrection(int32 NextShotIndex, int32 NextPatternIndex, const FVector2D& Delta);
+
+	/**
+	 * @brief Quantizes the state for replication, snapshots or save games.
+	 *
+	 * Shots still in flight in the accumulating mode are merged into a single shot with their remaining recoil.
+	 * @return The packed state.
+	 */
+	FMayRecoilPackedState Pack() const;
+
+	/**
+	 * @brief Restores the state from a packed state.
+	 * @param Packed The packed state.
+	 * @param InRecoilData The recoil data the state was packed with.
+	 */
+	void Unpack(const FMayRecoilPackedState& Packed, UMayRecoilData* InRecoilData);
+
+	/** @return Whether the state still has to be advanced. */
+	FORCEINLINE bool IsActive() const { return Phase != EMayRecoilPhase::Idle; }
+
+	/** @return Whether the reset delay of a state with bDeferReset expired since the last call. */
+	FORCEINLINE bool ConsumeResetDue()
+	{
+		const bool bDue = bResetDue;
+		bResetDue = false;
+		return bDue;
+	}
+
+	// ================================================================
+	// Properties
+	// ================================================================
+
+	/** The recoil data of the last shot. */
+	UPROPERTY(BlueprintReadOnly, Category = "MayRecoil")
+	UMayRecoilData* RecoilData = nullptr;
+
+	/** Current phase of the state. */
+	UPROPERTY(BlueprintReadOnly, Category = "MayRecoil")
+	EMayRecoilPhase Phase = EMayRecoilPhase::Idle;
+
+	/** Normalized progress of the current add or reset phase. */
+	UPROPERTY(BlueprintReadOnly, Category = "MayRecoil")
+	float Alpha = 0.0f;
+
+	/** Remaining time until the reset starts. */
+	UPROPERTY(BlueprintReadOnly, Category = "MayRecoil")
+	float ResetDelayRemaining = 0.0f;
+
+	/** Pitch the player added against the reset (see AMayRecoilWorker::TempRecoilResetPitchOffset). */
+	UPROPERTY(BlueprintReadOnly, Category = "MayRecoil")
+	float ResetPitchOffset = 0.0f;
+
+	/** Number of shots since the last reset, selects the entry of the static pattern. */
+	UPROPERTY(BlueprintReadOnly, Category = "MayRecoil")
+	int32 PatternIndex = 0;
+
+	/** Random stream used to generate the strength of each shot. */
+	UPROPERTY(BlueprintReadOnly, Category = "MayRecoil")
+	FMayRecoilRandom Random;
+
+	/** Yaw (X) and pitch (Y) strength of the current shot. */
+	UPROPERTY(BlueprintReadOnly, Category = "MayRecoil")
+	FVector2D ShotYawAndPitch = FVector2D::ZeroVector;
+
+	/** Yaw (X) and pitch (Y) already applied during the current phase. */
+	UPROPERTY(BlueprintReadOnly, Category = "MayRecoil")
+	FVector2D AppliedYawAndPitch = FVector2D::ZeroVector;
+
+	/** Accumulated yaw (X) and pitch (Y) that has not been reset yet. */
+	UPROPERTY(BlueprintReadOnly, Category = "MayRecoil")
+	FVector2D AddedPitchAndYaw = FVector2D::ZeroVector;
+
+	/** Accumulated yaw (X) and pitch (Y) at the start of the reset. */
+	UPROPERTY(BlueprintReadOnly, Category = "MayRecoil")
+	FVector2D ResetFromPitchAndYaw = FVector2D::ZeroVector;
+
+	/** In-flight shots if the recoil data accumulates shots. */
+	FMayRecoilShotAccumulator ShotAccumulator;
+
+	/** Clock of the fixed steps, see AdvanceFixed. */
+	FMayRecoilFixedStep StepClock;
+
+	/**
+	 * Whether the owner starts the reset phase itself. The state goes idle when the reset delay expires and
+	 * ConsumeResetDue returns true once, e.g. to call the ResetRecoil hook of a UMayRecoilWorkerObject.
+	 */
+	bool bDeferReset = false;
+
+	/** Whether the reset delay expired while bDeferReset is set, see ConsumeResetDue. */
+	bool bResetDue = false;
+};
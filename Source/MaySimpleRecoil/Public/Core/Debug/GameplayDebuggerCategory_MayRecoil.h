@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_GAMEPLAY_DEBUGGER
+
+#include "GameplayDebuggerCategory.h"
+
+class AActor;
+class APlayerController;
+
+/**
+ * Gameplay Debugger category showing the recoil state of the debug actor.
+ * Works for both the actor worker and the subsystem worker mode.
+ */
+class MAYSIMPLERECOIL_API FGameplayDebuggerCategory_MayRecoil : public FGameplayDebuggerCategory
+{
+public:
+	FGameplayDebuggerCategory_MayRecoil();
+
+	virtual void CollectData(APlayerController* OwnerPC, AActor* DebugActor) override;
+
+	static TSharedRef<FGameplayDebuggerCategory> MakeInstance();
+};
+
+#endif // WITH_GAMEPLAY_DEBUGGER
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Engine.h"
+
+/**
+ * Compile-time switch for all recoil debug output.
+ * Enabled in all configurations except Shipping and Test, can be overridden by defining it in a Build.cs.
+ */
+#ifndef MAYRECOIL_DEBUG
+#define MAYRECOIL_DEBUG !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+#endif
+
+#if MAYRECOIL_DEBUG
+
+namespace MayRecoilDebug
+{
+	/** Returns whether the on-screen debug messages are enabled (MayRecoil.Debug.OnScreen) */
+	MAYSIMPLERECOIL_API bool IsOnScreenEnabled();
+}
+
+/**
+ * Prints an on-screen debug message if MayRecoil.Debug.OnScreen is set.
+ * The message is only formatted when enabled and compiled out entirely without MAYRECOIL_DEBUG.
+ */
+#define MAYRECOIL_DEBUG_MESSAGE(Key, Color, Format, ...) \
+	do \
+	{ \
+		if (GEngine && MayRecoilDebug::IsOnScreenEnabled()) \
+		{ \
+			GEngine->AddOnScreenDebugMessage(Key, 5.0f, Color, FString::Printf(Format, ##__VA_ARGS__)); \
+		} \
+	} while (0)
+
+#else
+
+#define MAYRECOIL_DEBUG_MESSAGE(Key, Color, Format, ...) do { } while (0)
+
+#endif
@@ -0,0 +1,434 @@
+/******************************************************************************
+ * Copyright (c) 2023 MayStudios (Sven Maibaum).
+ * All Rights Reserved.
+ *
+ * This software and its accompanying documentation are the exclusive property
+ * of MayStudios (Sven Maibaum). No part of this software may be reproduced,
+ * distributed, modified, or transmitted in any form or by any means, including
+ * without limitation electronic, mechanical, or otherwise, without the prior
+ * written permission of the owner.
+ *
+ * This software is licensed for sale exclusively on fab. Unauthorized use,
+ * copying, or distribution is strictly prohibited.
+ *
+ * For licensing inquiries or further information, please contact:
+ * [Insert your contact information or website URL here].
+ *
+ * Author: Sven Maibaum
+ * Project: MayStudios
+*****************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Math/RandomStream.h"
+
+class UMayRecoilData;
+
+/**
+ * @brief Native replacement for a non-looping FTimeline with a linear 0..1 curve of one second.
+ *
+ * Advances a normalized position by DeltaTime * PlayRate without any curve asset or
+ * delegate dispatch.
+ */
+struct MAYSIMPLERECOIL_API FMayRecoilPlayback
+{
+	/** Normalized position between 0 and 1. */
+	float Position = 0.0f;
+
+	/** Speed at which the position advances per second. */
+	float PlayRate = 1.0f;
+
+	/** Whether the playback is currently running. */
+	bool bPlaying = false;
+
+	/**
+	 * @brief Restarts the playback from zero.
+	 * @param InPlayRate Speed at which the position advances per second.
+	 */
+	void PlayFromStart(float InPlayRate)
+	{
+		Position = 0.0f;
+		PlayRate = InPlayRate;
+		bPlaying = true;
+	}
+
+	/**
+	 * @brief Stops the playback at its current position.
+	 */
+	void Stop()
+	{
+		bPlaying = false;
+	}
+
+	/**
+	 * @brief Advances the playback.
+	 * @param DeltaTime The time to advance.
+	 * @return True if the playback reached its end during this step.
+	 */
+	bool Advance(float DeltaTime)
+	{
+		if (!bPlaying) return false;
+
+		Position = FMath::Min(Position + DeltaTime * PlayRate, 1.0f);
+		if (Position >= 1.0f)
+		{
+			bPlaying = false;
+			return true;
+		}
+		return false;
+	}
+};
+
+/**
+ * @brief Clock of a recoil advanced in fixed steps (see UMayRecoilSettings::FixedStepRate).
+ *
+ * Steps are counted against the absolute world time, so the remainder of each frame carries over
+ * to the next one and any sequence of frame times reaches the same step at the same time.
+ */
+struct MAYSIMPLERECOIL_API FMayRecoilFixedStep
+{
+	/** Number of steps since the world started. */
+	int64 StepCount = 0;
+
+	/**
+	 * @brief Moves the clock to the given time.
+	 * @param Time The current world time.
+	 * @param StepRate Steps per second.
+	 * @param MaxSteps Maximum number of steps returned, the rest is dropped.
+	 * @return The number of steps to take.
+	 */
+	int32 Consume(double Time, float StepRate, int32 MaxSteps)
+	{
+		const int64 Target = GetStep(Time, StepRate);
+		const int64 NumSteps = FMath::Clamp<int64>(Target - StepCount, 0, MaxSteps);
+		StepCount = FMath::Max(StepCount, Target);
+		return static_cast<int32>(NumSteps);
+	}
+
+	/**
+	 * @brief Moves the clock to the given time without taking any steps.
+	 * @param Time The current world time.
+	 * @param StepRate Steps per second.
+	 */
+	void Sync(double Time, float StepRate)
+	{
+		StepCount = GetStep(Time, StepRate);
+	}
+
+	/** @return The step at the given time. Times on a step boundary that are off by rounding count as that step. */
+	static int64 GetStep(double Time, float StepRate)
+	{
+		return FMath::FloorToInt64(Time * StepRate + 1.0e-6);
+	}
+};
+
+/**
+ * @brief Normalized easing function baked into a small lookup table.
+ *
+ * Sampled with linear interpolation instead of evaluating pow / sin / sqrt every step.
+ * Linear and Step are cheaper to evaluate directly and are never baked, functions with an infinite
+ * slope at the ends are evaluated directly as well (see CanBake).
+ */
+struct MAYSIMPLERECOIL_API FMayRecoilEasingTable
+{
+	/** Number of intervals of the table. */
+	static constexpr int32 NumIntervals = 64;
+
+	/** Maximum absolute error of a baked table against FMayRecoilEvaluator::EaseAlpha. */
+	static constexpr float MaxBakeError = 0.003f;
+
+	/**
+	 * @brief Returns whether a table for the given easing settings stays within MaxBakeError.
+	 *
+	 * Circular functions and EaseIn / EaseOut / EaseInOut with a blend exponent below 1 have an infinite
+	 * slope at 0 or 1, the first interval would be off by a few percent of the shot. Blend exponents above 6
+	 * bend too sharply for the table as well.
+	 * @param InEasingFunc The easing function.
+	 * @param InBlendExp Blend exponent of the EaseIn / EaseOut / EaseInOut functions.
+	 */
+	static bool CanBake(EEasingFunc::Type InEasingFunc, float InBlendExp);
+
+	/**
+	 * @brief Bakes the table for the given easing settings.
+	 * @param InEasingFunc The easing function.
+	 * @param InBlendExp Blend exponent of the EaseIn / EaseOut / EaseInOut functions.
+	 * @param InSteps Number of steps of the Step function.
+	 */
+	void Bake(EEasingFunc::Type InEasingFunc, float InBlendExp, int32 InSteps);
+
+	/**
+	 * @brief Returns whether the table has been baked for the given easing settings.
+	 */
+	FORCEINLINE bool IsBakedFor(EEasingFunc::Type InEasingFunc, float InBlendExp, int32 InSteps) const
+	{
+		return bBaked && EasingFunc == InEasingFunc && BlendExp == InBlendExp && Steps == InSteps;
+	}
+
+	/**
+	 * @brief Samples the baked table.
+	 * @param Alpha The linear alpha between 0 and 1.
+	 * @return The eased alpha.
+	 */
+	FORCEINLINE float Sample(float Alpha) const
+	{
+		const float Scaled = FMath::Clamp(Alpha, 0.0f, 1.0f) * NumIntervals;
+		const int32 Index = FMath::Min(FMath::TruncToInt(Scaled), NumIntervals - 1);
+		return FMath::Lerp(Samples[Index], Samples[Index + 1], Scaled - Index);
+	}
+
+	/** Eased alpha at Index / NumIntervals. */
+	float Samples[NumIntervals + 1] = {};
+
+	/** Settings the table was baked for. */
+	EEasingFunc::Type EasingFunc = EEasingFunc::Linear;
+	float BlendExp = 0.0f;
+	int32 Steps = 0;
+
+	/** Whether the table holds baked samples. */
+	bool bBaked = false;
+};
+
+struct FMayRecoilEasing;
+
+/**
+ * @brief Computes eased recoil offsets directly from the progress of a phase.
+ *
+ * Every easing function of UKismetMathLibrary::Ease is a lerp with a remapped alpha, so the
+ * remapped alpha is computed once and shared by yaw and pitch.
+ */
+struct MAYSIMPLERECOIL_API FMayRecoilEvaluator
+{
+	/**
+	 * @brief Remaps a linear alpha with the given easing function.
+	 *
+	 * Equivalent to UKismetMathLibrary::Ease(0, 1, Alpha, EasingFunc, BlendExp, Steps).
+	 * @param Alpha The linear alpha between 0 and 1.
+	 * @param EasingFunc The easing function.
+	 * @param BlendExp Blend exponent of the EaseIn / EaseOut / EaseInOut functions.
+	 * @param Steps Number of steps of the Step function.
+	 * @return The eased alpha.
+	 */
+	static float EaseAlpha(float Alpha, EEasingFunc::Type EasingFunc, float BlendExp, int32 Steps);
+
+	/**
+	 * @brief Remaps many linear alphas with the same easing function, four at a time.
+	 *
+	 * Vectorized with VectorRegister4Float (SSE / NEON), the alphas that do not fill a register and platforms
+	 * without vector intrinsics use EaseAlpha. Matches EaseAlpha within float precision.
+	 * UMayRecoilSubsystem eases the add and reset alphas of its states with it, see FMayRecoilEaseBatch.
+	 * @param Alphas The linear alphas between 0 and 1.
+	 * @param OutEased Receives the eased alphas, at least as many as Alphas.
+	 * @param EasingFunc The easing function.
+	 * @param BlendExp Blend exponent of the EaseIn / EaseOut / EaseInOut functions.
+	 * @param Steps Number of steps of the Step function.
+	 */
+	static void EaseAlphaBatch(TConstArrayView<float> Alphas, TArrayView<float> OutEased, EEasingFunc::Type EasingFunc, float BlendExp, int32 Steps);
+
+	/**
+	 * @brief Remaps a linear alpha, using the baked table if it matches the easing settings.
+	 * @param Table The baked table.
+	 * @param Alpha The linear alpha between 0 and 1.
+	 * @param EasingFunc The easing function.
+	 * @param BlendExp Blend exponent of the EaseIn / EaseOut / EaseInOut functions.
+	 * @param Steps Number of steps of the Step function.
+	 * @return The eased alpha.
+	 */
+	static FORCEINLINE float EaseAlpha(const FMayRecoilEasingTable& Table, float Alpha, EEasingFunc::Type EasingFunc, float BlendExp, int32 Steps)
+	{
+		// Settings are BlueprintReadWrite and may have changed since the table was baked
+		return Table.IsBakedFor(EasingFunc, BlendExp, Steps) ? Table.Sample(Alpha) : EaseAlpha(Alpha, EasingFunc, BlendExp, Steps);
+	}
+
+	/**
+	 * @brief Returns the easing of the add phase of a recoil data asset.
+	 * @param Data The recoil data providing the add interpolation settings.
+	 * @return The easing settings with the baked table.
+	 */
+	static FMayRecoilEasing GetAddEasing(const UMayRecoilData& Data);
+
+	/**
+	 * @brief Returns the easing of the reset phase of a recoil data asset.
+	 * @param Data The recoil data providing the reset interpolation settings.
+	 * @return The easing settings with the baked table.
+	 */
+	static FMayRecoilEasing GetResetEasing(const UMayRecoilData& Data);
+
+	/**
+	 * @brief Evaluates the applied recoil of a shot.
+	 * @param Data The recoil data providing the add interpolation settings.
+	 * @param YawAndPitch The yaw (X) and pitch (Y) strength of the shot.
+	 * @param Alpha The progress of the add phase between 0 and 1.
+	 * @return The eased yaw (X) and pitch (Y).
+	 */
+	static FVector2D EvaluateAdd(const UMayRecoilData& Data, const FVector2D& YawAndPitch, float Alpha);
+
+	/**
+	 * @brief Evaluates the reset recoil.
+	 * @param Data The recoil data providing the reset interpolation settings.
+	 * @param YawAndPitch The accumulated yaw (X) and pitch (Y) at the start of the reset.
+	 * @param Alpha The progress of the reset phase between 0 and 1.
+	 * @return The eased yaw (X) and pitch (Y) that has been reset.
+	 */
+	static FVector2D EvaluateReset(const UMayRecoilData& Data, const FVector2D& YawAndPitch, float Alpha);
+
+	/**
+	 * @brief Generates the yaw and pitch strength of a single shot.
+	 * @param Data The recoil data providing the pattern and strength settings.
+	 * @param Scale The recoil scale of the shot.
+	 * @param Stream The random stream seeded for this shot.
+	 * @param PatternShotIndex Number of shots since the last reset, selects the static pattern entry.
+	 * @return The yaw (X) and pitch (Y) strength of the shot.
+	 */
+	static FVector2D EvaluateShot(const UMayRecoilData& Data, float Scale, FRandomStream& Stream, int32 PatternShotIndex);
+};
+
+/**
+ * @brief Easing settings of the add or reset phase of a recoil data asset, together with its baked table.
+ */
+struct MAYSIMPLERECOIL_API FMayRecoilEasing
+{
+	/** The table baked for the phase, see UMayRecoilData::AddEasingTable. */
+	const FMayRecoilEasingTable* Table = nullptr;
+
+	/** The easing function. */
+	EEasingFunc::Type EasingFunc = EEasingFunc::Linear;
+
+	/** Blend exponent of the EaseIn / EaseOut / EaseInOut functions. */
+	float BlendExp = 2.0f;
+
+	/** Number of steps of the Step function. */
+	int32 Steps = 2;
+
+	/** @return Whether the table has been baked for these settings. */
+	FORCEINLINE bool IsBaked() const
+	{
+		return Table && Table->IsBakedFor(EasingFunc, BlendExp, Steps);
+	}
+
+	/**
+	 * @brief Remaps a linear alpha, using the baked table if it matches the settings.
+	 * @param Alpha The linear alpha between 0 and 1.
+	 * @return The eased alpha.
+	 */
+	FORCEINLINE float Ease(float Alpha) const
+	{
+		return IsBaked() ? Table->Sample(Alpha) : FMayRecoilEvaluator::EaseAlpha(Alpha, EasingFunc, BlendExp, Steps);
+	}
+};
+
+/**
+ * @brief Alphas of many recoil states grouped by their easing settings, eased with one EaseAlphaBatch call per group.
+ *
+ * Only settings without a baked table are worth batching, sampling a table is cheaper than the vectorized functions.
+ * The groups keep their memory across Reset, so a batch reused every frame does not allocate.
+ */
+struct MAYSIMPLERECOIL_API FMayRecoilEaseBatch
+{
+	/** Alphas of all items with the same easing settings. */
+	struct FGroup
+	{
+		EEasingFunc::Type EasingFunc = EEasingFunc::Linear;
+		float BlendExp = 0.0f;
+		int32 Steps = 0;
+
+		/** Index of each item in the caller's array, e.g. the index of the recoil state. */
+		TArray<int32> Items;
+
+		/** Linear alpha of each item. */
+		TArray<float> Alphas;
+
+		/** Eased alpha of each item, filled by Ease. */
+		TArray<float> Eased;
+	};
+
+	/**
+	 * @brief Adds the alpha of an item to the group of its easing settings.
+	 * @param Item Index of the item in the caller's array.
+	 * @param Alpha The linear alpha between 0 and 1.
+	 * @param Easing The easing settings.
+	 */
+	void Add(int32 Item, float Alpha, const FMayRecoilEasing& Easing);
+
+	/**
+	 * @brief Eases the alphas of all groups.
+	 */
+	void Ease();
+
+	/**
+	 * @brief Removes all items, the groups keep their memory.
+	 */
+	void Reset();
+
+	/** @return The groups in use since the last Reset. */
+	TArrayView<FGroup> GetGroups() { return MakeArrayView(Groups.GetData(), NumGroups); }
+
+private:
+	/** Groups of this and earlier frames, only the first NumGroups are in use. */
+	TArray<FGroup, TInlineAllocator<4>> Groups;
+
+	/** Number of groups in use since the last Reset. */
+	int32 NumGroups = 0;
+};
+
+/**
+ * @brief In-flight shots of the accumulating recoil mode (UMayRecoilData::AccumulateShots).
+ *
+ * Instead of restarting the add phase on every shot, each shot keeps its own progress and the
+ * contributions of all shots are superimposed. Shots queued during the same frame start together
+ * and are merged into a single entry, so any number of shots per frame produces one delta.
+ */
+struct MAYSIMPLERECOIL_API FMayRecoilShotAccumulator
+{
+	/** A single in-flight shot (or all shots queued in the same frame). */
+	struct FShot
+	{
+		/** Yaw (X) and pitch (Y) strength of the shot. */
+		FVector2D YawAndPitch = FVector2D::ZeroVector;
+
+		/** Progress of the add phase of this shot. */
+		float Alpha = 0.0f;
+	};
+
+	/**
+	 * @brief Queues a shot that starts with the next Advance.
+	 * @param YawAndPitch The yaw (X) and pitch (Y) strength of the shot.
+	 */
+	void Queue(const FVector2D& YawAndPitch)
+	{
+		PendingYawAndPitch += YawAndPitch;
+		bHasPending = true;
+	}
+
+	/**
+	 * @brief Advances all in-flight shots.
+	 * @param Data The recoil data providing speed and interpolation settings.
+	 * @param DeltaTime The time to advance.
+	 * @return The summed yaw (X) and pitch (Y) of all shots for this step.
+	 */
+	FVector2D Advance(const UMayRecoilData& Data, float DeltaTime);
+
+	/**
+	 * @brief Drops all queued and in-flight shots.
+	 */
+	void Reset()
+	{
+		Shots.Reset();
+		PendingYawAndPitch = FVector2D::ZeroVector;
+		bHasPending = false;
+	}
+
+	/** @return Whether any shot is queued or in flight. */
+	FORCEINLINE bool IsActive() const { return bHasPending || Shots.Num() > 0; }
+
+	/** Shots currently in flight. */
+	TArray<FShot, TInlineAllocator<8>> Shots;
+
+	/** Summed strength of the shots queued this frame. */
+	FVector2D PendingYawAndPitch = FVector2D::ZeroVector;
+
+	/** Whether shots have been queued this frame. */
+	bool bHasPending = false;
+};
@@ -0,0 +1,121 @@
+/******************************************************************************
+ * Copyright (c) 2023 MayStudios (Sven Maibaum).
+ * All Rights Reserved.
+ *
+ * This software and its accompanying documentation are the exclusive property
+ * of MayStudios (Sven Maibaum). No part of this software may be reproduced,
+ * distributed, modified, or transmitted in any form or by any means, including
+ * without limitation electronic, mechanical, or otherwise, without the prior
+ * written permission of the owner.
+ *
+ * This software is licensed for sale exclusively on fab. Unauthorized use,
+ * copying, or distribution is strictly prohibited.
+ *
+ * For licensing inquiries or further information, please contact:
+ * [Insert your contact information or website URL here].
+ *
+ * Author: Sven Maibaum
+ * Project: MayStudios
+*****************************************************************************/
+
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/Data/MayRecoilState.h"
+#include "Core/Interface/MayRecoilStateInterface.h"
+
+class UMayRecoilData;
+
+/**
+ * @brief Input of a single recoil simulation step.
+ */
+struct MAYSIMPLERECOIL_API FMayRecoilFrameInput
+{
+	/** Recoil data of the shot fired this step, no shot is fired if null. */
+	UMayRecoilData* FireRecoilData = nullptr;
+
+	/** Movement state used for the scale of the shot. */
+	EMayRecoilMovementState MovementState = EMayRecoilMovementState::None;
+
+	/** Yaw and pitch added by the player this step (see UMaySimpleRecoilComponent::OnYawAdded / OnPitchAdded). */
+	float PlayerYaw = 0.0f;
+	float PlayerPitch = 0.0f;
+};
+
+/**
+ * @brief Pure fixed-step recoil simulation for lockstep and rollback netcode.
+ *
+ * The whole recoil of a character is an FMayRecoilState plus the seed of its component, there is no timeline or
+ * latent action involved. Saving a state is a copy, so a character can be rewound and resimulated any number of steps.
+ */
+struct MAYSIMPLERECOIL_API FMayRecoilSimulation
+{
+	/**
+	 * @brief Advances a recoil state by one step.
+	 *
+	 * Applies the player input, fires the shot of the step and advances the phases, in this order.
+	 * @param State The state to advance.
+	 * @param Seed The recoil seed of the component (UMaySimpleRecoilComponent::RecoilSeed).
+	 * @param Input The input of this step.
+	 * @param DeltaTime The fixed step time.
+	 * @return The yaw (X) and pitch (Y) to apply to the player for this step.
+	 */
+	static FVector2D Step(FMayRecoilState& State, int32 Seed, const FMayRecoilFrameInput& Input, float DeltaTime);
+
+	/**
+	 * @brief Advances a recoil state by one frame the way UMayRecoilSubsystem does.
+	 *
+	 * Without fixed steps this is Step with the frame time. With fixed steps the state is advanced up to Time
+	 * before the shot is fired, like UMayRecoilSubsystem::Recoil does.
+	 * @param State The state to advance.
+	 * @param Seed The recoil seed of the component (UMaySimpleRecoilComponent::RecoilSeed).
+	 * @param Input The input of this frame.
+	 * @param Time The world time at the end of this frame.
+	 * @param DeltaTime The frame time.
+	 * @param StepRate Fixed steps per second, 0 to advance by DeltaTime.
+	 * @param MaxSteps Maximum number of fixed steps per frame.
+	 * @return The yaw (X) and pitch (Y) to apply to the player for this frame.
+	 */
+	static FVector2D SimulateFrame(FMayRecoilState& State, int32 Seed, const FMayRecoilFrameInput& Input, double Time, float DeltaTime, float StepRate, int32 MaxSteps);
+};
+
+/**
+ * @brief Ring buffer of recoil states keyed by simulation frame.
+ *
+ * Holds the last Capacity frames. Save after every simulated frame, restore the frame to rewind to and resimulate from there.
+ */
+class MAYSIMPLERECOIL_API FMayRecoilStateHistory
+{
+public:
+	explicit FMayRecoilStateHistory(int32 InCapacity = 64);
+
+	/**
+	 * @brief Saves the state of a frame, overwriting the oldest frame if the buffer is full.
+	 * @param Frame The simulation frame.
+	 * @param State The state after the frame.
+	 */
+	void SaveState(int32 Frame, const FMayRecoilState& State);
+
+	/**
+	 * @brief Restores the state of a frame.
+	 * @param Frame The simulation frame.
+	 * @param OutState Receives the state if the frame is still in the buffer.
+	 * @return Whether the frame was found.
+	 */
+	bool RestoreState(int32 Frame, FMayRecoilState& OutState) const;
+
+	/** Drops all saved frames. */
+	void Reset();
+
+	/** @return The number of frames the buffer holds. */
+	FORCEINLINE int32 GetCapacity() const { return States.Num(); }
+
+private:
+	/** Saved states, slot Frame % Capacity. */
+	TArray<FMayRecoilState> States;
+
+	/** Frame saved in each slot, INDEX_NONE if empty. */
+	TArray<int32> Frames;
+};
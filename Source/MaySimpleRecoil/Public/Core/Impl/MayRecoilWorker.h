@@ -24,17 +24,34 @@
 #include "CoreMinimal.h"
 #include "Components/TimelineComponent.h"
 #include "GameFramework/Actor.h"
+#include "Core/Impl/MayRecoilEvaluator.h"
+#include "Core/Data/MayRecoilState.h"
 #include "MayRecoilWorker.generated.h"
 
 class UMaySimpleRecoilComponent;
 class UMayRecoilData;
 
+/**
+ * @brief Defines how the worker advances the add and reset phases.
+ */
+UENUM(BlueprintType)
+enum class EMayRecoilEvaluationMode : uint8
+{
+	/** Progress is computed natively from RecoilSpeed / RecoilResetSpeed and the easing settings. No curves are required. */
+	Analytic,
+	/** Compatibility mode: both phases are driven by FTimelines using AddRecoilCurve and ResetRecoilCurve. */
+	TimelineCurves
+};
+
 /**
  * @brief Actor that handles the recoil effect.
  *
- * This actor uses two timelines:
- * - One timeline (AddRecoilTimeline) to apply the recoil effect.
- * - Another timeline (ResetRecoilTimeline) to reset the recoil effect.
+ * This actor uses two phases:
+ * - One phase (AddRecoil) to apply the recoil effect.
+ * - Another phase (ResetRecoil) to reset the recoil effect.
+ *
+ * By default both phases are evaluated analytically (see FMayRecoilEvaluator). With
+ * EMayRecoilEvaluationMode::TimelineCurves they are driven by two timelines and custom curves instead.
  *
  * It works in conjunction with a recoil component (UMaySimpleRecoilComponent) and recoil data (UMayRecoilData)
  * to calculate and update the player's yaw and pitch values accordingly.
@@ -62,9 +79,20 @@ protected:
 	 */
 	virtual void BeginPlay() override;
 
+	/**
+	 * @brief Called after the worker has been loaded, switches workers with curves to TimelineCurves.
+	 */
+	virtual void PostLoad() override;
+
+	/**
+	 * @brief Called when the actor is removed from play.
+	 * @param EndPlayReason The reason why play ended.
+	 */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:
 	/**
-	 * @brief Called every frame.
+	 * @brief Called every frame while a recoil timeline is playing.
 	 * @param DeltaTime The time elapsed since the last frame.
 	 */
 	virtual void Tick(float DeltaTime) override;
@@ -205,18 +233,26 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MayRecoil")
 	UMayRecoilData* CurrentRecoilData;
 
+	/**
+	 * How the add and reset phases are advanced.
+	 * Workers that have AddRecoilCurve or ResetRecoilCurve assigned are switched to TimelineCurves on load,
+	 * so existing Blueprints keep their curves.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MayRecoil")
+	EMayRecoilEvaluationMode EvaluationMode = EMayRecoilEvaluationMode::Analytic;
+
 	/** Timeline for applying recoil. */
 	FTimeline AddRecoilTimeline;
 
 	/** Curve used for interpolation in the AddRecoil timeline. */
-	UPROPERTY(EditAnywhere, Category = "Timeline")
+	UPROPERTY(EditAnywhere, Category = "Timeline", meta = (EditCondition = "EvaluationMode == EMayRecoilEvaluationMode::TimelineCurves"))
 	UCurveFloat* AddRecoilCurve;
 
 	/** Timeline for resetting recoil. */
 	FTimeline ResetRecoilTimeline;
 
 	/** Curve used for interpolation in the ResetRecoil timeline. */
-	UPROPERTY(EditAnywhere, Category = "Timeline")
+	UPROPERTY(EditAnywhere, Category = "Timeline", meta = (EditCondition = "EvaluationMode == EMayRecoilEvaluationMode::TimelineCurves"))
 	UCurveFloat* ResetRecoilCurve;
 
 	// ================================================================
@@ -235,6 +271,44 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Temp Runtime")
 	float TempAddedPitch = 0.0f;
 
+	/** @return The yaw (X) and pitch (Y) strength of the current shot. */
+	FVector2D GetCurrentOutYawAndPitch() const { return FVector2D(CurrentOutYaw, CurrentOutPitch); }
+
+	/** @return The accumulated yaw (X) and pitch (Y) that has not been reset yet. */
+	FVector2D GetAddedPitchAndYaw() const { return AddedPitchAndYaw; }
+
+	/**
+	 * @brief Applies a server correction (see UMaySimpleRecoilComponent::bServerAuthoritativeRecoil).
+	 * @param NextShotIndex The shot index to continue with.
+	 * @param NextPatternIndex The pattern index to continue with.
+	 * @param Delta The yaw (X) and pitch (Y) added to match the server.
+	 */
+	void ApplyCorrection(int32 NextShotIndex, int32 NextPatternIndex, const FVector2D& Delta);
+
+	/**
+	 * @brief Quantizes the current recoil state for replication, snapshots or save games.
+	 * @return The packed state.
+	 */
+	FMayRecoilPackedState PackState() const;
+
+	/**
+	 * @brief Restores the recoil state and continues the phase it was packed in.
+	 * @param Packed The packed state.
+	 */
+	void UnpackState(const FMayRecoilPackedState& Packed);
+
+	/** @return Whether the add phase is currently playing. */
+	bool IsAddRecoilPlaying() const;
+
+	/** @return Whether the reset phase is currently playing. */
+	bool IsResetRecoilPlaying() const;
+
+	/** @return The current position of the add phase. */
+	float GetAddRecoilPosition() const;
+
+	/** @return The current position of the reset phase. */
+	float GetResetRecoilPosition() const;
+
 private:
 	/**
 	 * @brief Initializes the recoil timelines.
@@ -244,6 +318,119 @@ private:
 	 */
 	void initialize_recoil_timelines();
 
+	/**
+	 * @brief Switches to TimelineCurves if curves are assigned but the worker is still in Analytic mode.
+	 *
+	 * Workers created before the analytic mode existed only had curves, the curves are unused in Analytic mode.
+	 */
+	void ResolveEvaluationMode();
+
+	/**
+	 * @brief Enables or disables the actor tick.
+	 *
+	 * The worker only ticks while one of its timelines is playing, so idle characters cost no tick time.
+	 * @param bAwake Whether the tick should be enabled.
+	 */
+	void SetTickAwake(bool bAwake);
+
+	/**
+	 * @brief Advances the worker in fixed steps up to the current world time (see UMayRecoilSettings::FixedStepRate).
+	 */
+	void AdvanceFixedSteps();
+
+	/**
+	 * @brief Advances the reset delay and the add and reset phases.
+	 *
+	 * A reset started by the expired delay advances from the next step on, the same step as in FMayRecoilState::Advance.
+	 * @param DeltaTime The time to advance.
+	 */
+	void AdvanceRecoil(float DeltaTime);
+
+	/**
+	 * @brief Advances the add and reset phases, either the timelines or the native playbacks and accumulated shots.
+	 * @param DeltaTime The time to advance.
+	 */
+	void AdvancePhases(float DeltaTime);
+
+	/**
+	 * @brief Adds yaw and pitch to the rotation applied at the end of the tick.
+	 * @param Yaw The yaw to add.
+	 * @param Pitch The pitch to add.
+	 */
+	void QueueYawAndPitch(float Yaw, float Pitch);
+
+	/**
+	 * @brief Applies the queued yaw and pitch to the player in a single call.
+	 */
+	void FlushYawAndPitch();
+
+	/**
+	 * @brief Plays the add phase.
+	 * @param PlayRate Speed at which the phase advances.
+	 * @param Position Normalized position to start from.
+	 */
+	void PlayAddRecoil(float PlayRate, float Position = 0.0f);
+
+	/**
+	 * @brief Plays the reset phase.
+	 * @param PlayRate Speed at which the phase advances.
+	 * @param Position Normalized position to start from.
+	 */
+	void PlayResetRecoil(float PlayRate, float Position = 0.0f);
+
+	/**
+	 * @brief Starts (or restarts) the delay after which the reset phase begins.
+	 *
+	 * The delay is counted down in Tick, no latent action is involved.
+	 * @param Duration The delay in seconds.
+	 */
+	void StartResetDelay(float Duration);
+
+	/**
+	 * @brief Cancels a running reset delay.
+	 */
+	void CancelResetDelay();
+
+	/**
+	 * @brief Stops the add phase.
+	 */
+	void StopAddRecoil();
+
+	/**
+	 * @brief Stops the reset phase.
+	 */
+	void StopResetRecoil();
+
+	/** Internal variable: number of shots since the last reset, selects the entry of the static pattern. */
+	int32 PatternIndex = 0;
+
+	/** Internal variable: deterministic random stream for the shot strengths. */
+	FMayRecoilRandom RecoilRandom;
+
+	/** Internal variable: native playback of the add phase in analytic mode. */
+	FMayRecoilPlayback AddRecoilPlayback;
+
+	/** Internal variable: native playback of the reset phase in analytic mode. */
+	FMayRecoilPlayback ResetRecoilPlayback;
+
+	/** Internal variable: yaw (X) and pitch (Y) queued during the current tick. */
+	FVector2D PendingYawAndPitch = FVector2D::ZeroVector;
+
+	/** Internal variable: in-flight shots if the recoil data accumulates shots (analytic mode only). */
+	FMayRecoilShotAccumulator ShotAccumulator;
+
+	/** Internal variable: remaining time until the reset phase begins. */
+	float ResetDelayRemaining = 0.0f;
+
+	/** Internal variable: whether the reset delay is counting down. */
+	bool bResetDelayActive = false;
+
+	/** Internal variable: clock of the fixed steps. */
+	FMayRecoilFixedStep FixedStep;
+
+	/** Internal variable: whether the actor tick is currently enabled. */
+	bool bTickAwake = false;
+
 	/** Internal variable: current calculated yaw value for recoil. */
 	float CurrentOutYaw = 0.0f;
 
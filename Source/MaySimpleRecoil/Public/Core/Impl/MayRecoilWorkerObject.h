@@ -0,0 +1,149 @@
+/******************************************************************************
+ * Copyright (c) 2023 MayStudios (Sven Maibaum).
+ * All Rights Reserved.
+ *
+ * This software and its accompanying documentation are the exclusive property
+ * of MayStudios (Sven Maibaum). No part of this software may be reproduced,
+ * distributed, modified, or transmitted in any form or by any means, including
+ * without limitation electronic, mechanical, or otherwise, without the prior
+ * written permission of the owner.
+ *
+ * This software is licensed for sale exclusively on fab. Unauthorized use,
+ * copying, or distribution is strictly prohibited.
+ *
+ * For licensing inquiries or further information, please contact:
+ * [Insert your contact information or website URL here].
+ *
+ * Author: Sven Maibaum
+ * Project: MayStudios
+*****************************************************************************/
+
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "MayRecoilWorkerObject.generated.h"
+
+class UMaySimpleRecoilComponent;
+class UMayRecoilData;
+class UMayRecoilSubsystem;
+struct FMayRecoilState;
+
+/**
+ * @brief Lightweight recoil worker without an actor (EMayRecoilWorkerMode::Object).
+ *
+ * The recoil state lives in the UMayRecoilSubsystem and is advanced by its batched tick, this object only provides
+ * the same BlueprintNativeEvent hooks as AMayRecoilWorker. A Blueprint subclass of AMayRecoilWorker that only overrides
+ * these hooks can be reparented to this class without changing its graphs.
+ */
+UCLASS(Blueprintable, BlueprintType)
+class MAYSIMPLERECOIL_API UMayRecoilWorkerObject : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	// ================================================================
+	// Setup: Component and Data Configuration
+	// ================================================================
+
+	/**
+	 * @brief Sets the current recoil component.
+	 * @param NewComponent Pointer to the new recoil component.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MayRecoil")
+	void SetCurrentComponent(UMaySimpleRecoilComponent* NewComponent);
+
+	/**
+	 * @brief Sets the current recoil data.
+	 * @param RecoilData Pointer to the new recoil data.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MayRecoil")
+	void SetCurrentRecoilData(UMayRecoilData* RecoilData);
+
+	// ================================================================
+	// Recoil Functionality
+	// ================================================================
+
+	/**
+	 * @brief Fires a shot with the strength from GetRecoilYawAndPitchStrength.
+	 */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "MayRecoil")
+	void Recoil();
+	virtual void Recoil_Implementation();
+
+	/**
+	 * @brief Starts resetting the accumulated recoil.
+	 */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "MayRecoil")
+	void ResetRecoil();
+	virtual void ResetRecoil_Implementation();
+
+	/**
+	 * @brief Immediately resets the recoil state.
+	 */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "MayRecoil")
+	void ResetRecoilState();
+	virtual void ResetRecoilState_Implementation();
+
+	// ================================================================
+	// Recoil Scaling and Strength Calculation
+	// ================================================================
+
+	/**
+	 * @brief Calculates the recoil scale factor based on the current component state.
+	 * @return The calculated recoil scale.
+	 */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "MayRecoil")
+	float GetRecoilScale();
+	virtual float GetRecoilScale_Implementation();
+
+	/**
+	 * @brief Calculates the yaw and pitch strengths for the recoil.
+	 * @param OutYaw Output parameter for the calculated yaw strength.
+	 * @param OutPitch Output parameter for the calculated pitch strength.
+	 */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "MayRecoil")
+	void GetRecoilYawAndPitchStrength(float& OutYaw, float& OutPitch);
+	virtual void GetRecoilYawAndPitchStrength_Implementation(float& OutYaw, float& OutPitch);
+
+	/**
+	 * @brief Called when additional yaw is added.
+	 * @param Yaw The yaw value to add.
+	 */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "MayRecoil")
+	void OnYawAdded(float Yaw);
+	virtual void OnYawAdded_Implementation(float Yaw);
+
+	/**
+	 * @brief Called when additional pitch is added.
+	 * @param Pitch The pitch value to add.
+	 */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "MayRecoil")
+	void OnPitchAdded(float Pitch);
+	virtual void OnPitchAdded_Implementation(float Pitch);
+
+	// ================================================================
+	// UObject Interface
+	// ================================================================
+
+	/** Allows world context nodes in Blueprint subclasses. */
+	virtual UWorld* GetWorld() const override;
+
+	// ================================================================
+	// Properties
+	// ================================================================
+
+	/** The recoil component this worker works for. */
+	UPROPERTY(BlueprintReadOnly, Category = "MayRecoil")
+	UMaySimpleRecoilComponent* CurrentComponent = nullptr;
+
+	/** The recoil data of the current shot. */
+	UPROPERTY(BlueprintReadOnly, Category = "MayRecoil")
+	UMayRecoilData* CurrentRecoilData = nullptr;
+
+private:
+	/** @return The subsystem holding the recoil state, nullptr if not available. */
+	UMayRecoilSubsystem* GetRecoilSubsystem() const;
+};
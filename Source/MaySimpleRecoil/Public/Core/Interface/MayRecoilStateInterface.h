@@ -3,6 +3,26 @@
 #include "UObject/Interface.h"
 #include "MayRecoilStateInterface.generated.h"
 
+/**
+ * Movement state of a character as a compact bitmask.
+ * Every bit except Fall scales the recoil, the Custom bits are project specific states (prone, leaning, bipod, ...)
+ * named in the project settings (UMayRecoilSettings) and set with UMaySimpleRecoilComponent::SetCustomMovementState.
+ */
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EMayRecoilMovementState : uint8
+{
+	None = 0 UMETA(Hidden),
+	Crouch = 1 << 0,
+	Sprint = 1 << 1,
+	Jump = 1 << 2,
+	ADS = 1 << 3,
+	Custom1 = 1 << 4,
+	Custom2 = 1 << 5,
+	Custom3 = 1 << 6,
+	Fall = 1 << 7
+};
+ENUM_CLASS_FLAGS(EMayRecoilMovementState)
+
 /**
  * Interface for dynamic state queries (Sprinting, Crouching, etc.)
  */
@@ -0,0 +1,221 @@
+/******************************************************************************
+ * Copyright (c) 2023 MayStudios (Sven Maibaum).
+ * All Rights Reserved.
+ *
+ * This software and its accompanying documentation are the exclusive property
+ * of MayStudios (Sven Maibaum). No part of this software may be reproduced,
+ * distributed, modified, or transmitted in any form or by any means, including
+ * without limitation electronic, mechanical, or otherwise, without the prior
+ * written permission of the owner.
+ *
+ * This software is licensed for sale exclusively on fab. Unauthorized use,
+ * copying, or distribution is strictly prohibited.
+ *
+ * For licensing inquiries or further information, please contact:
+ * [Insert your contact information or website URL here].
+ *
+ * Author: Sven Maibaum
+ * Project: MayStudios
+*****************************************************************************/
+
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/Interface/MayRecoilStateInterface.h"
+#include "MayRecoilNetTypes.generated.h"
+
+namespace MayRecoilNet
+{
+	/** Resolution of quantized angles, 1/100 degree. */
+	constexpr float AngleScale = 100.0f;
+
+	/** Quantizes an angle in degrees to 1/100 degree. */
+	FORCEINLINE int16 QuantizeAngle(float Degrees)
+	{
+		return static_cast<int16>(FMath::Clamp(FMath::RoundToInt(Degrees * AngleScale), static_cast<int32>(MIN_int16), static_cast<int32>(MAX_int16)));
+	}
+
+	/** Restores an angle quantized with QuantizeAngle. */
+	FORCEINLINE float DequantizeAngle(int16 Quantized)
+	{
+		return Quantized / AngleScale;
+	}
+
+	/** Quantizes a normalized value between 0 and 1 to 16 bit. */
+	FORCEINLINE uint16 QuantizeUnit(float Value)
+	{
+		return static_cast<uint16>(FMath::RoundToInt(FMath::Clamp(Value, 0.0f, 1.0f) * MAX_uint16));
+	}
+
+	/** Restores a value quantized with QuantizeUnit. */
+	FORCEINLINE float DequantizeUnit(uint16 Quantized)
+	{
+		return Quantized / static_cast<float>(MAX_uint16);
+	}
+
+	/** Quantizes a time in seconds to milliseconds, up to about 65 seconds. */
+	FORCEINLINE uint16 QuantizeTime(float Seconds)
+	{
+		return static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(Seconds * 1000.0f), 0, static_cast<int32>(MAX_uint16)));
+	}
+
+	/** Restores a time quantized with QuantizeTime. */
+	FORCEINLINE float DequantizeTime(uint16 Quantized)
+	{
+		return Quantized / 1000.0f;
+	}
+}
+
+/**
+ * @brief Recoil of a single shot predicted by a client, sent to the server for validation.
+ */
+USTRUCT()
+struct MAYSIMPLERECOIL_API FMayRecoilNetShot
+{
+	GENERATED_BODY()
+
+	/** Index of the shot in the random stream (FMayRecoilRandom::ShotIndex). */
+	UPROPERTY()
+	int32 ShotIndex = 0;
+
+	/** Index of the shot in the static pattern. */
+	UPROPERTY()
+	int16 PatternIndex = 0;
+
+	/** Predicted yaw and pitch, quantized to 1/100 degree. */
+	UPROPERTY()
+	int16 Yaw = 0;
+
+	UPROPERTY()
+	int16 Pitch = 0;
+
+	/** EMayRecoilMovementState of the client when the shot was fired. */
+	UPROPERTY()
+	uint8 MovementState = 0;
+
+	FMayRecoilNetShot() = default;
+
+	FMayRecoilNetShot(int32 InShotIndex, int32 InPatternIndex, EMayRecoilMovementState InMovementState, float InYaw, float InPitch)
+		: ShotIndex(InShotIndex)
+		, PatternIndex(static_cast<int16>(FMath::Min(InPatternIndex, static_cast<int32>(MAX_int16))))
+		, Yaw(MayRecoilNet::QuantizeAngle(InYaw))
+		, Pitch(MayRecoilNet::QuantizeAngle(InPitch))
+		, MovementState(static_cast<uint8>(InMovementState))
+	{
+	}
+
+	FORCEINLINE FVector2D GetYawAndPitch() const { return FVector2D(MayRecoilNet::DequantizeAngle(Yaw), MayRecoilNet::DequantizeAngle(Pitch)); }
+	FORCEINLINE EMayRecoilMovementState GetMovementState() const { return static_cast<EMayRecoilMovementState>(MovementState); }
+};
+
+/**
+ * @brief Correction sent by the server if the recoil predicted by a client does not match.
+ */
+USTRUCT()
+struct MAYSIMPLERECOIL_API FMayRecoilNetCorrection
+{
+	GENERATED_BODY()
+
+	/** Shot index the client continues with. */
+	UPROPERTY()
+	int32 NextShotIndex = 0;
+
+	/** Pattern index the client continues with. */
+	UPROPERTY()
+	int16 NextPatternIndex = 0;
+
+	/** Yaw and pitch the client has to add to match the server, quantized to 1/100 degree. */
+	UPROPERTY()
+	int16 DeltaYaw = 0;
+
+	UPROPERTY()
+	int16 DeltaPitch = 0;
+
+	FMayRecoilNetCorrection() = default;
+
+	FMayRecoilNetCorrection(int32 InNextShotIndex, int32 InNextPatternIndex, const FVector2D& Delta)
+		: NextShotIndex(InNextShotIndex)
+		, NextPatternIndex(static_cast<int16>(FMath::Min(InNextPatternIndex, static_cast<int32>(MAX_int16))))
+		, DeltaYaw(MayRecoilNet::QuantizeAngle(Delta.X))
+		, DeltaPitch(MayRecoilNet::QuantizeAngle(Delta.Y))
+	{
+	}
+
+	FORCEINLINE FVector2D GetDelta() const { return FVector2D(MayRecoilNet::DequantizeAngle(DeltaYaw), MayRecoilNet::DequantizeAngle(DeltaPitch)); }
+};
+
+/**
+ * @brief Recoil state (FMayRecoilState) quantized to a few bytes, for replication, rollback snapshots and save games.
+ *
+ * Angles are stored in 1/100 degree, the phase progress in 16 bit and the reset delay in milliseconds. The yaw and
+ * pitch already applied in the current phase is not stored, it follows from the shot, the progress and the recoil data.
+ * NetSerialize only writes the fields the current phase needs, an idle state takes four bytes plus the packed shot indices.
+ */
+USTRUCT(BlueprintType)
+struct MAYSIMPLERECOIL_API FMayRecoilPackedState
+{
+	GENERATED_BODY()
+
+	/** EMayRecoilPhase */
+	UPROPERTY(SaveGame)
+	uint8 Phase = 0;
+
+	/** Progress of the add or reset phase. */
+	UPROPERTY(SaveGame)
+	uint16 Alpha = 0;
+
+	/** Remaining reset delay in milliseconds. */
+	UPROPERTY(SaveGame)
+	uint16 ResetDelayRemaining = 0;
+
+	/** Shot strength, accumulated recoil, accumulated recoil at the start of the reset and reset pitch offset in 1/100 degree. */
+	UPROPERTY(SaveGame)
+	int16 ShotYaw = 0;
+
+	UPROPERTY(SaveGame)
+	int16 ShotPitch = 0;
+
+	UPROPERTY(SaveGame)
+	int16 AddedYaw = 0;
+
+	UPROPERTY(SaveGame)
+	int16 AddedPitch = 0;
+
+	UPROPERTY(SaveGame)
+	int16 ResetFromYaw = 0;
+
+	UPROPERTY(SaveGame)
+	int16 ResetFromPitch = 0;
+
+	UPROPERTY(SaveGame)
+	int16 ResetPitchOffset = 0;
+
+	/** Index of the next shot in the random stream and in the static pattern. */
+	UPROPERTY(SaveGame)
+	int32 ShotIndex = 0;
+
+	UPROPERTY(SaveGame)
+	int32 PatternIndex = 0;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FMayRecoilPackedState& Other) const
+	{
+		return Phase == Other.Phase && Alpha == Other.Alpha && ResetDelayRemaining == Other.ResetDelayRemaining &&
+			ShotYaw == Other.ShotYaw && ShotPitch == Other.ShotPitch && AddedYaw == Other.AddedYaw && AddedPitch == Other.AddedPitch &&
+			ResetFromYaw == Other.ResetFromYaw && ResetFromPitch == Other.ResetFromPitch && ResetPitchOffset == Other.ResetPitchOffset &&
+			ShotIndex == Other.ShotIndex && PatternIndex == Other.PatternIndex;
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FMayRecoilPackedState> : public TStructOpsTypeTraitsBase2<FMayRecoilPackedState>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true
+	};
+};
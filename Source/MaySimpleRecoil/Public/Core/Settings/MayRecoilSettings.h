@@ -0,0 +1,132 @@
+/******************************************************************************
+ * Copyright (c) 2023 MayStudios (Sven Maibaum).
+ * All Rights Reserved.
+ *
+ * This software and its accompanying documentation are the exclusive property
+ * of MayStudios (Sven Maibaum). No part of this software may be reproduced,
+ * distributed, modified, or transmitted in any form or by any means, including
+ * without limitation electronic, mechanical, or otherwise, without the prior
+ * written permission of the owner.
+ *
+ * This software is licensed for sale exclusively on fab. Unauthorized use,
+ * copying, or distribution is strictly prohibited.
+ *
+ * For licensing inquiries or further information, please contact:
+ * [Insert your contact information or website URL here].
+ *
+ * Author: Sven Maibaum
+ * Project: MayStudios
+*****************************************************************************/
+
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "MayRecoilSettings.generated.h"
+
+class AMayRecoilWorker;
+
+/**
+ * @brief Project specific movement state that scales the recoil (prone, leaning, bipod, ...).
+ */
+USTRUCT(BlueprintType)
+struct MAYSIMPLERECOIL_API FMayRecoilCustomState
+{
+	GENERATED_BODY()
+
+	/** Name of the state, only used for display. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MaySimpleRecoil")
+	FName Name;
+
+	/** Recoil scale while the state is active, unless the recoil data overrides the scale settings. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MaySimpleRecoil")
+	float DefaultScale = 1.0f;
+};
+
+/**
+ * @brief Project wide settings of MaySimpleRecoil (Project Settings > Plugins > May Simple Recoil).
+ *
+ * Holds the recoil scales used by every UMayRecoilData that does not set OverrideScaleSettings.
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "May Simple Recoil"))
+class MAYSIMPLERECOIL_API UMayRecoilSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	/** Maximum number of custom states, see EMayRecoilMovementState::Custom1..Custom3. */
+	static constexpr int32 MaxCustomStates = 3;
+
+	// ============================== Recoil Scale ==============================
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Scale")
+	float RecoilScale = 1.0f;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Scale")
+	float RecoilScaleSprint = 2.0f;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Scale")
+	float RecoilScaleCrouch = 0.25f;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Scale")
+	float RecoilScaleJump = 1.0f;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Scale")
+	float RecoilScaleADS = 1.0f;
+
+	/** Additional states, the first entry is EMayRecoilMovementState::Custom1. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Scale", meta = (TitleProperty = "Name"))
+	TArray<FMayRecoilCustomState> CustomStates;
+
+	// ============================== Simulation ==============================
+
+	/**
+	 * Rate in Hz at which the recoil is advanced in fixed steps, independent of the frame rate. 0 advances once per frame
+	 * with the frame time. With fixed steps, clients at any frame rate and the server apply the same total recoil.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Simulation", meta = (ClampMin = "0", UIMin = "0", UIMax = "240"))
+	float FixedStepRate = 0.0f;
+
+	/** Maximum number of fixed steps per frame, the rest of a longer hitch is dropped. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Simulation", meta = (ClampMin = "1"))
+	int32 MaxFixedStepsPerFrame = 16;
+
+	/**
+	 * Advances the states of the UMayRecoilSubsystem on worker threads (ParallelFor) and applies the rotations
+	 * on the game thread in a single pass afterwards. Only used with at least ParallelUpdateMinStates registered states.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Simulation")
+	bool bParallelUpdate = false;
+
+	/** Minimum number of registered states for the parallel update, below this the update runs on the game thread. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Simulation", meta = (ClampMin = "1", EditCondition = "bParallelUpdate"))
+	int32 ParallelUpdateMinStates = 256;
+
+	/** Speed at which yaw input of the player pulls the accumulated yaw back to zero, per second. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Simulation", meta = (ClampMin = "0"))
+	float PlayerYawRecoverySpeed = 10.0f;
+
+	// ============================== Worker Pool ==============================
+
+	/** Number of recoil workers spawned per world on BeginPlay, acquired by components in EMayRecoilWorkerMode::Actor. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Worker Pool", meta = (ClampMin = "0"))
+	int32 WorkerPoolSize = 8;
+
+	/** Worker class spawned for the pool, AMayRecoilWorker if not set. Components using another class add their workers to the pool on BeginPlay. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Worker Pool")
+	TSoftClassPtr<AMayRecoilWorker> PooledWorkerClass;
+
+	/** @return Whether the recoil is advanced in fixed steps. */
+	FORCEINLINE bool UseFixedStep() const { return FixedStepRate > 0.0f; }
+
+	/** @return Number of custom states that are taken into account. */
+	FORCEINLINE int32 GetNumCustomStates() const { return FMath::Min(CustomStates.Num(), MaxCustomStates); }
+
+	virtual FName GetCategoryName() const override { return TEXT("Plugins"); }
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+};
@@ -0,0 +1,252 @@
+/******************************************************************************
+ * Copyright (c) 2023 MayStudios (Sven Maibaum).
+ * All Rights Reserved.
+ *
+ * This software and its accompanying documentation are the exclusive property
+ * of MayStudios (Sven Maibaum). No part of this software may be reproduced,
+ * distributed, modified, or transmitted in any form or by any means, including
+ * without limitation electronic, mechanical, or otherwise, without the prior
+ * written permission of the owner.
+ *
+ * This software is licensed for sale exclusively on fab. Unauthorized use,
+ * copying, or distribution is strictly prohibited.
+ *
+ * For licensing inquiries or further information, please contact:
+ * [Insert your contact information or website URL here].
+ *
+ * Author: Sven Maibaum
+ * Project: MayStudios
+*****************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Core/Data/MayRecoilState.h"
+#include "MayRecoilSubsystem.generated.h"
+
+class UMaySimpleRecoilComponent;
+class UMayRecoilData;
+class AMayRecoilWorker;
+
+/**
+ * @brief World subsystem that owns and advances the recoil state of all registered components.
+ *
+ * Components using EMayRecoilWorkerMode::Subsystem or EMayRecoilWorkerMode::Object register here instead of spawning their own
+ * AMayRecoilWorker. All states are kept in one contiguous array and advanced in a single tick,
+ * which only runs while at least one state is active.
+ *
+ * Also pools the AMayRecoilWorker actors of components using EMayRecoilWorkerMode::Actor, so
+ * acquiring a worker on possession or on the first shot does not spawn an actor.
+ */
+UCLASS()
+class MAYSIMPLERECOIL_API UMayRecoilSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ================================================================
+	// Registration
+	// ================================================================
+
+	/**
+	 * @brief Registers a component and allocates a recoil state for it.
+	 * @param Component The component to register.
+	 */
+	void RegisterComponent(UMaySimpleRecoilComponent* Component);
+
+	/**
+	 * @brief Unregisters a component and releases its recoil state.
+	 * @param Component The component to unregister.
+	 */
+	void UnregisterComponent(UMaySimpleRecoilComponent* Component);
+
+	/**
+	 * @brief Returns the recoil state of a registered component.
+	 * @param Component The registered component.
+	 * @return The recoil state, or nullptr if the component is not registered.
+	 */
+	FMayRecoilState* FindState(const UMaySimpleRecoilComponent* Component);
+
+	// ================================================================
+	// Recoil Functionality
+	// ================================================================
+
+	/**
+	 * @brief Starts the recoil of a new shot for a registered component.
+	 * @param Component The registered component.
+	 * @param RecoilData The recoil data used for this shot.
+	 */
+	void Recoil(UMaySimpleRecoilComponent* Component, UMayRecoilData* RecoilData);
+
+	/**
+	 * @brief Starts the recoil of a shot with an already calculated strength.
+	 * @param Component The registered component.
+	 * @param RecoilData The recoil data used for this shot.
+	 * @param Yaw The yaw strength of the shot.
+	 * @param Pitch The pitch strength of the shot.
+	 */
+	void Fire(UMaySimpleRecoilComponent* Component, UMayRecoilData* RecoilData, float Yaw, float Pitch);
+
+	/**
+	 * @brief Starts resetting the accumulated recoil of a registered component unless a shot is still being applied.
+	 * @param Component The registered component.
+	 */
+	void BeginReset(UMaySimpleRecoilComponent* Component);
+
+	/**
+	 * @brief Immediately resets the recoil state of a registered component.
+	 * @param Component The registered component.
+	 */
+	void ResetRecoilState(UMaySimpleRecoilComponent* Component);
+
+	/**
+	 * @brief Restores the recoil state of a registered component from a packed state.
+	 * @param Component The registered component.
+	 * @param PackedState The packed state.
+	 * @param RecoilData The recoil data the state was packed with.
+	 */
+	void RestoreState(UMaySimpleRecoilComponent* Component, const FMayRecoilPackedState& PackedState, UMayRecoilData* RecoilData);
+
+	/** @return The number of states that are currently active. */
+	int32 GetNumActiveStates() const { return NumActiveStates; }
+
+	// ================================================================
+	// Worker Pool
+	// ================================================================
+
+	/**
+	 * @brief Registers a component that acquires workers of a class, the pool keeps a free worker for it.
+	 *
+	 * Called on BeginPlay of components in EMayRecoilWorkerMode::Actor, so a worker of any class is spawned
+	 * there and not on possession. Workers bound to components of the class count towards it.
+	 * @param WorkerClass The worker class, AMayRecoilWorker if null.
+	 */
+	void AddWorkerDemand(TSubclassOf<AMayRecoilWorker> WorkerClass);
+
+	/**
+	 * @brief Unregisters a component registered with AddWorkerDemand.
+	 *
+	 * Its free worker stays in the pool until TrimWorkers.
+	 * @param WorkerClass The worker class, AMayRecoilWorker if null.
+	 */
+	void RemoveWorkerDemand(TSubclassOf<AMayRecoilWorker> WorkerClass);
+
+	/**
+	 * @brief Takes a free worker of the given class from the pool and binds it to a component.
+	 *
+	 * Spawns a new worker only if the pool has no free worker of this class.
+	 * @param WorkerClass The worker class, AMayRecoilWorker if null.
+	 * @param Component The component the worker works for.
+	 * @return The worker, nullptr if it could not be spawned.
+	 */
+	AMayRecoilWorker* AcquireWorker(TSubclassOf<AMayRecoilWorker> WorkerClass, UMaySimpleRecoilComponent* Component);
+
+	/**
+	 * @brief Clears a worker and returns it to the pool.
+	 * @param Worker The worker acquired with AcquireWorker.
+	 */
+	void ReleaseWorker(AMayRecoilWorker* Worker);
+
+	/**
+	 * @brief Spawns free workers until the pool holds the given number of workers of a class.
+	 * @param WorkerClass The worker class.
+	 * @param Count The number of free workers.
+	 */
+	void PrewarmWorkers(TSubclassOf<AMayRecoilWorker> WorkerClass, int32 Count);
+
+	/**
+	 * @brief Destroys free workers until the pool holds at most the given number of workers.
+	 *
+	 * The workers released last are destroyed first, e.g. the ones spawned for a burst of components.
+	 * @param Count The number of free workers to keep.
+	 */
+	void TrimWorkers(int32 Count);
+
+	/** @return The number of free workers in the pool. */
+	int32 GetNumFreeWorkers() const { return FreeWorkers.Num(); }
+
+	// ================================================================
+	// UWorldSubsystem Interface
+	// ================================================================
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// ================================================================
+	// FTickableGameObject Interface
+	// ================================================================
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	/** Recoil states of all registered components. */
+	UPROPERTY(Transient)
+	TArray<FMayRecoilState> States;
+
+	/** Owning component of each state, same index as States. */
+	UPROPERTY(Transient)
+	TArray<UMaySimpleRecoilComponent*> Components;
+
+	/** Number of states that are currently active. */
+	int32 NumActiveStates = 0;
+
+	/**
+	 * @brief Advances a range of states and writes their yaw and pitch to StateDeltas.
+	 *
+	 * Only touches the states of the range, so ranges may run on worker threads.
+	 * @param Begin The index of the first state.
+	 * @param End The index after the last state.
+	 * @param DeltaTime The frame time.
+	 * @param Time The current world time.
+	 * @param Batch The ease batch of this range.
+	 */
+	void AdvanceStates(int32 Begin, int32 End, float DeltaTime, double Time, FMayRecoilEaseBatch& Batch);
+
+	/** Yaw (X) and pitch (Y), due resets, number of steps and component of each state in this tick. Kept to reuse the memory. */
+	TArray<FVector2D> StateDeltas;
+	TArray<bool> StateResetDue;
+	TArray<int32> StateSteps;
+	TArray<UMaySimpleRecoilComponent*> StateComponents;
+
+	/** Ease batch of each range of states advanced by AdvanceStates. Kept to reuse the memory. */
+	TArray<FMayRecoilEaseBatch> EaseBatches;
+
+	/**
+	 * @brief Advances a state in fixed steps up to the current world time, if fixed steps are enabled.
+	 * @param Index The index of the state.
+	 */
+	void AdvanceToCurrentStep(int32 Index);
+
+	/**
+	 * @brief Calls the ResetRecoil hook of the worker object of a component whose reset delay expired.
+	 *
+	 * States of EMayRecoilWorkerMode::Object components defer their reset (FMayRecoilState::bDeferReset), so
+	 * Blueprint overrides of UMayRecoilWorkerObject::ResetRecoil run like the ones of AMayRecoilWorker.
+	 * @param Component The component of the state.
+	 */
+	static void NotifyResetDue(UMaySimpleRecoilComponent* Component);
+
+	/**
+	 * @brief Spawns a pooled worker.
+	 * @param WorkerClass The worker class.
+	 * @return The worker, nullptr if it could not be spawned.
+	 */
+	AMayRecoilWorker* SpawnWorker(TSubclassOf<AMayRecoilWorker> WorkerClass);
+
+	/** Workers that are not bound to a component. */
+	UPROPERTY(Transient)
+	TArray<AMayRecoilWorker*> FreeWorkers;
+
+	/** Components and bound workers of a worker class, see AddWorkerDemand. */
+	struct FWorkerDemand
+	{
+		int32 NumComponents = 0;
+		int32 NumBoundWorkers = 0;
+	};
+
+	/** Demand per worker class. The classes are referenced by the components that registered them. */
+	TMap<UClass*, FWorkerDemand> WorkerDemands;
+};
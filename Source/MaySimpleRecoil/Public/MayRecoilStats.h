@@ -0,0 +1,40 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_STATS_GROUP(TEXT("MayRecoil"), STATGROUP_MayRecoil, STATCAT_Advanced);
+
+/** Number of AMayRecoilWorker actors that currently have their tick enabled */
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Awake Workers"), STAT_MayRecoilAwakeWorkers, STATGROUP_MayRecoil, MAYSIMPLERECOIL_API);
+
+/** Number of active recoil states of the UMayRecoilSubsystem */
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active States"), STAT_MayRecoilActiveStates, STATGROUP_MayRecoil, MAYSIMPLERECOIL_API);
+
+/** Number of shots fired this frame */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Shots"), STAT_MayRecoilShots, STATGROUP_MayRecoil, MAYSIMPLERECOIL_API);
+
+/** Number of resets restarted this frame because the player pulled down against them */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Reset Restarts"), STAT_MayRecoilResetRestarts, STATGROUP_MayRecoil, MAYSIMPLERECOIL_API);
+
+/** Scoped timers, use MAYRECOIL_SCOPE_CYCLE_COUNTER */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Recoil"), STAT_MayRecoilRecoil, STATGROUP_MayRecoil, MAYSIMPLERECOIL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Generate Shot"), STAT_MayRecoilGenerateShot, STATGROUP_MayRecoil, MAYSIMPLERECOIL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Worker Tick"), STAT_MayRecoilWorkerTick, STATGROUP_MayRecoil, MAYSIMPLERECOIL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Subsystem Tick"), STAT_MayRecoilSubsystemTick, STATGROUP_MayRecoil, MAYSIMPLERECOIL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Player Yaw And Pitch"), STAT_MayRecoilUpdatePlayer, STATGROUP_MayRecoil, MAYSIMPLERECOIL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Reset"), STAT_MayRecoilReset, STATGROUP_MayRecoil, MAYSIMPLERECOIL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Advance Phases"), STAT_MayRecoilAdvancePhases, STATGROUP_MayRecoil, MAYSIMPLERECOIL_API);
+
+/**
+ * Cycle stat that stays visible in Unreal Insights when stats are compiled out (STATS=0, e.g. Test and Shipping).
+ * With stats the cycle counter already emits the CPU trace scope, so the trace scope is only added without them.
+ */
+#if STATS
+#define MAYRECOIL_SCOPE_CYCLE_COUNTER(Stat) SCOPE_CYCLE_COUNTER(Stat)
+#else
+#define MAYRECOIL_SCOPE_CYCLE_COUNTER(Stat) TRACE_CPUPROFILER_EVENT_SCOPE(Stat)
+#endif
@@ -41,14 +41,16 @@ void FMayRecoilDataCustomization::CustomizeDetails(IDetailLayoutBuilder& DetailB
 		GET_MEMBER_NAME_CHECKED(UMayRecoilData, MaxRecoilHorizontalStrength),
 		GET_MEMBER_NAME_CHECKED(UMayRecoilData, ForceMinMaxVerticalStrength),
 		GET_MEMBER_NAME_CHECKED(UMayRecoilData, ForceMinMaxHorizontalStrength),
-		// GET_MEMBER_NAME_CHECKED(UMayRecoilData, UseStaticPattern),
-		// GET_MEMBER_NAME_CHECKED(UMayRecoilData, StaticPattern),
+		GET_MEMBER_NAME_CHECKED(UMayRecoilData, UseStaticPattern),
+		GET_MEMBER_NAME_CHECKED(UMayRecoilData, StaticPattern),
+		GET_MEMBER_NAME_CHECKED(UMayRecoilData, LoopStaticPattern),
 		GET_MEMBER_NAME_CHECKED(UMayRecoilData, OverrideScaleSettings),
 		GET_MEMBER_NAME_CHECKED(UMayRecoilData, RecoilScale),
 		GET_MEMBER_NAME_CHECKED(UMayRecoilData, RecoilScaleSprint),
 		GET_MEMBER_NAME_CHECKED(UMayRecoilData, RecoilScaleCrouch),
 		GET_MEMBER_NAME_CHECKED(UMayRecoilData, RecoilScaleJump),
 		GET_MEMBER_NAME_CHECKED(UMayRecoilData, RecoilScaleADS),
+		GET_MEMBER_NAME_CHECKED(UMayRecoilData, RecoilScaleCustom),
 		GET_MEMBER_NAME_CHECKED(UMayRecoilData, NumShots),
 		GET_MEMBER_NAME_CHECKED(UMayRecoilData, Iterations),
 		GET_MEMBER_NAME_CHECKED(UMayRecoilData, BulletRadius),
@@ -219,6 +221,38 @@ void FMayRecoilDataCustomization::GenerateRecoilPattern(const int32 TexSize, TAr
 	}
 }
 
+void FMayRecoilDataCustomization::GenerateStaticRecoilPattern(const int32 TexSize, TArray<FColor>& PixelData)
+{
+	const TArray<FStaticPatternData>& Pattern = DataAssetPtr->StaticPattern;
+	const int32 Iterations = DataAssetPtr->Iterations;
+
+	const float CenterX = TexSize * 0.5f;
+	const float CenterY = TexSize * 0.5f;
+
+	for (int32 Iter = 0; Iter < Iterations; ++Iter)
+	{
+		float CurrentX = CenterX;
+		float CurrentY = CenterY;
+
+		for (int32 Shot = 0; Shot < Pattern.Num(); ++Shot)
+		{
+			FColor ShotColor = GetGradientColor(Shot, Pattern.Num());
+
+			DrawCircleOnTexture(PixelData, TexSize, FMath::RoundToInt(CurrentX), FMath::RoundToInt(CurrentY), DataAssetPtr->BulletRadius, ShotColor);
+
+			const FStaticPatternData& ShotData = Pattern[Shot];
+			float Vert = ShotData.Point.Y + FMath::FRandRange(ShotData.MinRecoilVerticalStrength, ShotData.MaxRecoilVerticalStrength);
+			float Horz = ShotData.Point.X + FMath::FRandRange(ShotData.MinRecoilHorizontalStrength, ShotData.MaxRecoilHorizontalStrength);
+
+			CurrentX += Horz * 5.0f;
+			CurrentY -= Vert * 5.0f;
+
+			CurrentX = FMath::Clamp(CurrentX, 0.0f, static_cast<float>(TexSize - 1));
+			CurrentY = FMath::Clamp(CurrentY, 0.0f, static_cast<float>(TexSize - 1));
+		}
+	}
+}
+
 void FMayRecoilDataCustomization::RebuildRecoilTextureFromData()
 {
     if (!DataAssetPtr) return;
@@ -258,20 +292,14 @@ void FMayRecoilDataCustomization::RebuildRecoilTextureFromData()
         }
     }
 	
- //    if (DataAssetPtr->UseStaticPattern)
-	// {
- //    	for (int32 Shot = 0; Shot < DataAssetPtr->StaticPattern.Num(); ++Shot)
-	// 	{
-	// 		FColor ShotColor = GetGradientColor(Shot, DataAssetPtr->StaticPattern.Num());
-	// 		DrawHollowEllipseOnTexture(PixelData, TexSize,
-	// 			DataAssetPtr->StaticPattern[Shot].Point.X, DataAssetPtr->StaticPattern[Shot].Point.Y,
-	// 			10, 10, ShotColor);
-	// 	}
-	// }
-	// else
-	// {
+    if (DataAssetPtr->UseStaticPattern && DataAssetPtr->StaticPattern.Num() > 0)
+	{
+		GenerateStaticRecoilPattern(TexSize, PixelData);
+	}
+	else
+	{
 		GenerateRecoilPattern(TexSize, PixelData);
-	// }
+	}
 	
     if (!GeneratedTexture)
     {
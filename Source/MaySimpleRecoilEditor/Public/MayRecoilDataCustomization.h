@@ -27,6 +27,7 @@ private:
 
 	void GenerateRecoilPattern_SIMD(const int32 TexSize, TArray<FColor>& PixelData);
 	void GenerateRecoilPattern(const int32 TexSize, TArray<FColor>& PixelData);
+	void GenerateStaticRecoilPattern(const int32 TexSize, TArray<FColor>& PixelData);
 
 	void RebuildRecoilTextureFromData();
 